@@ -36,6 +36,11 @@ typedef enum
     CAML_KEY_ALREADY_EXIST,
     CAML_WRONG_GETTER_TYPE,
     CAML_API_NOT_ENABLED,
+    CAML_OBJECT_FROZEN,
+    CAML_QUEUE_FULL,
+    CAML_QUEUE_EMPTY,
+    CAML_BUFFER_TOO_SMALL,
+    CAML_END_OF_BATCH,
 } CAMLErrorCode;
 
 #endif // C_AML_ERRORCODES_H_
\ No newline at end of file
@@ -19,6 +19,7 @@
 #define C_AML_INTERFACE_H_
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "camlerrorcodes.h"
 
@@ -39,6 +40,16 @@ typedef void * amlObjectHandle_t;
  */
 typedef void * amlDataHandle_t;
 
+/**
+ * AMLPatch handle
+ */
+typedef void * amlPatchHandle_t;
+
+/**
+ * A bounded queue of amlObjectHandle_t which can be shared by threads without locks.
+ */
+typedef void * amlObjectQueue_t;
+
 
 typedef enum
 {
@@ -80,6 +91,22 @@ AML_EXPORT CAMLErrorCode CreateAMLObjectWithID(const char* deviceId,
                                                const char* id,
                                                amlObjectHandle_t* amlObjHandle);
 
+/**
+ * @brief       Create an instance of AMLObject with a numeric timestamp.
+ * @param       deviceId        [in] Device id that source device of AMLObject.
+ * @param       epoch           [in] timestamp of AMLObject in milliseconds since the Unix epoch.
+ * @param       amlObjHandle    [out] handle of created AMLObject.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory to AMLObject instance.
+ * @note        The timeStamp of AMLObject is the decimal string of 'epoch'. (See AMLObject_GetEpoch())
+ *              AMLObject instance will be allocated, so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLObject().
+ */
+AML_EXPORT CAMLErrorCode CreateAMLObjectWithEpoch(const char* deviceId,
+                                                  const int64_t epoch,
+                                                  amlObjectHandle_t* amlObjHandle);
+
 /**
  * @brief       Destroy an instance of AMLObject.
  * @param       amlObjHandle    [in] AMLObject that will be destroyed.
@@ -89,6 +116,35 @@ AML_EXPORT CAMLErrorCode CreateAMLObjectWithID(const char* deviceId,
  */
 AML_EXPORT CAMLErrorCode DestroyAMLObject(amlObjectHandle_t amlObjHandle);
 
+/**
+ * @brief       Create instances of AMLObject at once.
+ * @param       deviceIds       [in] array of device ids that are source devices of AMLObjects.
+ * @param       timeStamps      [in] array of timestamp values of AMLObjects delivered by devices.
+ * @param       count           [in] the number of AMLObjects to create, which is the size of all arrays.
+ * @param       amlObjHandles   [out] array that receives handles of created AMLObjects.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory to AMLObject instances.
+ * @note        Either all or none of AMLObjects are created.
+ *              AMLObject instances are allocated in a single block and registered under a single lock,
+ *              each of them should be deleted after use by DestroyAMLObject() or DestroyAMLObjects().
+ */
+AML_EXPORT CAMLErrorCode CreateAMLObjects(const char** deviceIds,
+                                          const char** timeStamps,
+                                          const size_t count,
+                                          amlObjectHandle_t* amlObjHandles);
+
+/**
+ * @brief       Destroy instances of AMLObject at once.
+ * @param       amlObjHandles   [in] array of AMLObjects that will be destroyed.
+ * @param       count           [in] the size of 'amlObjHandles'.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid or duplicated handle. None of AMLObjects is destroyed.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLObjects(amlObjectHandle_t* amlObjHandles,
+                                           const size_t count);
+
 /**
  * @brief       Clone an instance of AMLObject.
  * @param       origin          [in] AMLObject that will be cloned.
@@ -147,6 +203,53 @@ AML_EXPORT CAMLErrorCode AMLObject_GetDataNames(const amlObjectHandle_t amlObjHa
                                                 char*** names,
                                                 size_t* namesSize);
 
+/**
+ * @brief       This function makes AMLObject and all AMLData in it read-only.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        Once frozen, AMLObject_AddData() on AMLObject and AMLData_SetValue*() on its AMLData
+ *              return #CAML_OBJECT_FROZEN. Getter APIs of a frozen AMLObject and its AMLData
+ *              can be called from multiple threads at the same time, without locks of the caller.
+ *              Each call still looks up its handle under the lock of the handle registry,
+ *              so frozen reads are safe, but not lock-free.
+ *              AMLObject cannot be unfrozen, but the one made by CloneAMLObject() is not frozen.
+ */
+AML_EXPORT CAMLErrorCode AMLObject_Freeze(amlObjectHandle_t amlObjHandle);
+
+/**
+ * @brief       This function returns the number of AMLData that AMLObject has.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       count           [out] the number of AMLData.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @see         AMLObject_GetDataAt
+ */
+AML_EXPORT CAMLErrorCode AMLObject_GetDataCount(const amlObjectHandle_t amlObjHandle,
+                                                size_t* count);
+
+/**
+ * @brief       This function returns the name and AMLData at 'index' of AMLObject.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       index           [in] index of AMLData, which is less than the count of AMLObject_GetDataCount().
+ * @param       name            [out] AMLData key.
+ * @param       amlDataHandle   [out] handle of AMLData value.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter or 'index' is out of range.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory to handle of AMLData.
+ * @note        AMLData are ordered by name, and the order is kept until AMLData is added to AMLObject.
+ *              'name' is owned by AMLObject, so it should not be freed.
+ *              It is valid until AMLData is added to AMLObject or AMLObject is destroyed.
+ */
+AML_EXPORT CAMLErrorCode AMLObject_GetDataAt(const amlObjectHandle_t amlObjHandle,
+                                             const size_t index,
+                                             const char** name,
+                                             amlDataHandle_t* amlDataHandle);
+
 /**
  * @brief       This function returns the deviceId of AMLObject.
  * @param       amlObjHandle    [in] handle of AMLObject.
@@ -175,6 +278,19 @@ AML_EXPORT CAMLErrorCode AMLObject_GetDeviceId(const amlObjectHandle_t amlObjHan
 AML_EXPORT CAMLErrorCode AMLObject_GetTimeStamp(const amlObjectHandle_t amlObjHandle,
                                                 char** timeStamp);
 
+/**
+ * @brief       This function returns the timeStamp of AMLObject as a number.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       epoch           [out] timestamp in milliseconds since the Unix epoch.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_WRONG_GETTER_TYPE timeStamp of AMLObject is not a decimal number.
+ * @note        No memory is allocated, unlike AMLObject_GetTimeStamp().
+ */
+AML_EXPORT CAMLErrorCode AMLObject_GetEpoch(const amlObjectHandle_t amlObjHandle,
+                                            int64_t* epoch);
+
 /**
  * @brief       This function returns the id of AMLObject.
  * @param       amlObjHandle    [in] handle of AMLObject.
@@ -189,6 +305,76 @@ AML_EXPORT CAMLErrorCode AMLObject_GetTimeStamp(const amlObjectHandle_t amlObjHa
 AML_EXPORT CAMLErrorCode AMLObject_GetId(const amlObjectHandle_t amlObjHandle,
                                          char** id);
 
+/**
+ * @brief       This function estimates the heap memory held by AMLObject, including its AMLDatas and handle.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       size            [out] estimated memory usage in bytes.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @note        The size is an estimate, not a measurement of allocations.
+ *              Strings and containers are counted by their allocated capacity, and nodes of maps and
+ *              value holders of AMLData by typical sizes of the standard library, which may differ.
+ *              Per-allocation bookkeeping of the memory allocator is not included.
+ */
+AML_EXPORT CAMLErrorCode AMLObject_GetEstimatedMemoryUsage(const amlObjectHandle_t amlObjHandle,
+                                                           size_t* size);
+
+/**
+ * @brief       This function creates a patch which contains the changes from 'prev' to 'curr'.
+ * @param       prev            [in] handle of previous AMLObject.
+ * @param       curr            [in] handle of current AMLObject.
+ * @param       patch           [out] handle of created AMLPatch.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory to AMLPatch instance.
+ * @note        Only changed values are contained, but deviceId, timeStamp and id are always taken from 'curr'.
+ *              AMLPatch instance will be allocated, so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLPatch().
+ */
+AML_EXPORT CAMLErrorCode AMLObject_Diff(const amlObjectHandle_t prev,
+                                        const amlObjectHandle_t curr,
+                                        amlPatchHandle_t* patch);
+
+/**
+ * @brief       This function creates a new AMLObject by applying a patch to 'base'.
+ * @param       base            [in] handle of AMLObject that the patch was made from. (See AMLObject_Diff())
+ * @param       patch           [in] handle of AMLPatch.
+ * @param       result          [out] handle of created AMLObject.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter, or the patch does not match to 'base'.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory to AMLObject instance.
+ * @note        'base' is not changed.
+ *              AMLObject instance will be allocated to 'result', so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLObject().
+ */
+AML_EXPORT CAMLErrorCode AMLObject_ApplyPatch(const amlObjectHandle_t base,
+                                              const amlPatchHandle_t patch,
+                                              amlObjectHandle_t* result);
+
+/**
+ * @brief       Destroy an instance of AMLPatch.
+ * @param       patch           [in] AMLPatch that will be destroyed.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLPatch(amlPatchHandle_t patch);
+
+/**
+ * @brief       This function returns the number of changes that AMLPatch has.
+ * @param       patch           [in] handle of AMLPatch.
+ * @param       count           [out] the number of changes.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @note        If 'count' is 0, AMLObjects that made the patch have the same AMLDatas.
+ */
+AML_EXPORT CAMLErrorCode AMLPatch_GetChangeCount(const amlPatchHandle_t patch,
+                                                 size_t* count);
+
 
 /**
  * @brief       Create an instance of AMLData.
@@ -209,6 +395,17 @@ AML_EXPORT CAMLErrorCode CreateAMLData(amlDataHandle_t* amlDataHandle);
  */
 AML_EXPORT CAMLErrorCode DestroyAMLData(amlDataHandle_t amlDataHandle);
 
+/**
+ * @brief       Destroy instances of AMLData at once.
+ * @param       amlDataHandles  [in] array of AMLData that will be destroyed.
+ * @param       count           [in] the size of 'amlDataHandles'.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid or duplicated handle. None of AMLData is destroyed.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLDataBatch(amlDataHandle_t* amlDataHandles,
+                                             const size_t count);
+
 /**
  * @brief       Clone an instance of AMLData.
  * @param       origin          [in] AMLData that will be cloned.
@@ -347,6 +544,62 @@ AML_EXPORT CAMLErrorCode AMLData_GetValueType(const amlDataHandle_t amlDataHandl
                                               const char* key,
                                               CAMLValueType* type);
 
+/**
+ * @brief       This function estimates the heap memory held by AMLData, including nested AMLData and its handle.
+ * @param       amlDataHandle   [in] handle of AMLData.
+ * @param       size            [out] estimated memory usage in bytes.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @note        The size is an estimate, as AMLObject_GetEstimatedMemoryUsage().
+ */
+AML_EXPORT CAMLErrorCode AMLData_GetEstimatedMemoryUsage(const amlDataHandle_t amlDataHandle,
+                                                         size_t* size);
+
+/**
+ * @brief       This function creates a bounded queue of AMLObject handles.
+ * @param       capacity    [in] max number of handles in the queue, which is rounded up to a power of two of at least 2.
+ * @param       queue       [out] created queue.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        AMLObjectQueue_Push() and AMLObjectQueue_Pop() can be called from any number of threads without locks.
+ *              The queue only moves handles, which stay valid in the handle registry while in the queue.
+ *              A pushed handle is handed over to the consumer which pops it,
+ *              so the producer should not use or destroy AMLObject after the push.
+ *              The queue should be deleted after use by DestroyAMLObjectQueue().
+ */
+AML_EXPORT CAMLErrorCode CreateAMLObjectQueue(const size_t capacity, amlObjectQueue_t* queue);
+
+/**
+ * @brief       This function destroys a queue of AMLObject handles.
+ * @param       queue       [in] queue to destroy.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @note        AMLObject of handles still in the queue are not destroyed.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLObjectQueue(amlObjectQueue_t queue);
+
+/**
+ * @brief       This function adds a handle of AMLObject at the tail of queue.
+ * @param       queue           [in] queue of AMLObject handles.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_QUEUE_FULL        Queue is full.
+ * @note        The handle is not validated, so the queue does not touch the handle registry.
+ */
+AML_EXPORT CAMLErrorCode AMLObjectQueue_Push(amlObjectQueue_t queue, amlObjectHandle_t amlObjHandle);
+
+/**
+ * @brief       This function takes a handle of AMLObject from the head of queue.
+ * @param       queue           [in] queue of AMLObject handles.
+ * @param       amlObjHandle    [out] handle of AMLObject.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_QUEUE_EMPTY       Queue is empty.
+ */
+AML_EXPORT CAMLErrorCode AMLObjectQueue_Pop(amlObjectQueue_t queue, amlObjectHandle_t* amlObjHandle);
 
 #ifdef __cplusplus
 }
@@ -25,6 +25,151 @@
 
 #define AML_EXPORT __attribute__ ((visibility("default")))
 
+/**
+ * Cycle of config information that is sent only once.
+ */
+#define CAML_CYCLE_ONCE     (-1)
+
+/**
+ * Serialized forms of AMLObject.
+ */
+typedef enum
+{
+    CAML_FORMAT_AML = 0,    // AML(XML) string of Representation_DataToAml()
+    CAML_FORMAT_BYTE        // byte data of Representation_DataToByte()
+} CAMLSerialFormat;
+
+/**
+ * Events of Representation_AmlParseEvents(), in the order of AML document.
+ * Keys and values are not null-terminated.
+ */
+typedef enum
+{
+    AMLPARSE_HEADER = 0,    // 'key' is "device", "id" or "timestamp" of AMLObject with its 'value'
+    AMLPARSE_DATA_BEGIN,    // 'key' is a name of AMLData in AMLObject
+    AMLPARSE_DATA_END,
+    AMLPARSE_VALUE,         // string 'value' of 'key', or an element of string array whose 'key' is its position
+    AMLPARSE_ARRAY_BEGIN,   // 'key' is a key of string array
+    AMLPARSE_ARRAY_END,
+    AMLPARSE_NESTED_BEGIN,  // 'key' is a key of nested AMLData
+    AMLPARSE_NESTED_END
+} CAMLParseEventType;
+
+typedef struct
+{
+    CAMLParseEventType type;
+    const char* key;
+    size_t keySize;
+    const char* value;      // NULL except for AMLPARSE_HEADER and AMLPARSE_VALUE
+    size_t valueSize;
+} CAMLParseEvent;
+
+/**
+ * Callback to receive a parse event.
+ * It returns 0 to continue, or non-zero to stop parsing.
+ */
+typedef int (*CAMLParseCallback)(const CAMLParseEvent* event, void* userData);
+
+/**
+ * Conversions of Representation_ConvertBatch().
+ */
+typedef enum
+{
+    CAML_CONVERT_DATA_TO_AML = 0,   // 'amlObj' to 'aml', as Representation_DataToAml()
+    CAML_CONVERT_DATA_TO_BYTE,      // 'amlObj' to 'byte' and 'size', as Representation_DataToByte()
+    CAML_CONVERT_AML_TO_DATA,       // 'aml' to 'amlObj', as Representation_AmlToData()
+    CAML_CONVERT_BYTE_TO_DATA       // 'byte' and 'size' to 'amlObj', as Representation_ByteToData()
+} CAMLConvertType;
+
+/**
+ * One conversion of Representation_ConvertBatch(), holding its input, output and result.
+ */
+typedef struct
+{
+    amlObjectHandle_t amlObj;
+    char* aml;
+    uint8_t* byte;
+    size_t size;
+    CAMLErrorCode result;
+} CAMLConvertItem;
+
+/**
+ * Result of an asynchronous conversion.
+ * Representation_DataToByteAsync() gives 'byte' and 'size', with 'amlObj' it converted.
+ * Representation_ByteToDataAsync() gives 'amlObj'.
+ */
+typedef struct
+{
+    CAMLErrorCode result;
+    amlObjectHandle_t amlObj;
+    uint8_t* byte;
+    size_t size;
+    void* userData;         // 'userData' of the request
+} CAMLCompletion;
+
+/**
+ * Callback to receive the result of an asynchronous conversion, called on a thread of the library.
+ */
+typedef void (*CAMLCompletionCallback)(const CAMLCompletion* completion);
+
+/**
+ * Stages of AML pipeline, in the order an item goes through them.
+ */
+typedef enum
+{
+    CAML_STAGE_BUILD = 0,   // record to AMLObject
+    CAML_STAGE_VALIDATE,    // AMLObject is checked
+    CAML_STAGE_SERIALIZE,   // AMLObject to CAMLSerialFormat
+    CAML_STAGE_SINK         // serialized data is delivered
+} CAMLPipelineStage;
+
+#define CAML_PIPELINE_STAGES    4
+
+/**
+ * What AMLPipeline_Push() and stages do when the queue of the next stage is full.
+ */
+typedef enum
+{
+    CAML_BACKPRESSURE_BLOCK = 0,    // wait until the queue has room
+    CAML_BACKPRESSURE_DROP_OLDEST   // drop the oldest item of the queue
+} CAMLBackpressurePolicy;
+
+/**
+ * Callbacks of AML pipeline, called on its threads. They return 0 to pass an item to the next stage,
+ * or non-zero to reject it.
+ */
+typedef int (*CAMLPipelineBuildCallback)(void* record, amlObjectHandle_t* amlObjHandle, void* userData);
+typedef int (*CAMLPipelineValidateCallback)(const amlObjectHandle_t amlObjHandle, void* userData);
+typedef int (*CAMLPipelineSinkCallback)(const char* deviceId, const uint8_t* data, size_t size, void* userData);
+
+/**
+ * Callback to release a record which is dropped before it is built.
+ */
+typedef void (*CAMLPipelineDiscardCallback)(void* record, void* userData);
+
+typedef struct
+{
+    CAMLPipelineBuildCallback build;
+    CAMLPipelineValidateCallback validate;  // NULL to pass all AMLObjects
+    CAMLSerialFormat format;
+    CAMLPipelineSinkCallback sink;
+    CAMLPipelineDiscardCallback discard;    // NULL if records need not be released
+    void* userData;                         // passed to the callbacks
+    size_t workers[CAML_PIPELINE_STAGES];   // threads of each stage, indexed by CAMLPipelineStage. 0 is 1.
+    size_t queueCapacity;                   // items waiting for each thread, rounded up to a power of two of at least 2
+    CAMLBackpressurePolicy backpressure;
+} CAMLPipelineConfig;
+
+typedef struct
+{
+    uint64_t processed;     // items passed to the next stage, or delivered by the sink
+    uint64_t rejected;      // items rejected by the stage, or failed in it
+    uint64_t dropped;       // items dropped from the queue of the stage by CAML_BACKPRESSURE_DROP_OLDEST
+    size_t queueDepth;      // items waiting for the stage
+    size_t queueCapacity;
+    double throughput;      // processed items per second since the pipeline is created
+} CAMLPipelineStageMetrics;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -35,6 +180,26 @@ extern "C"
  */
 typedef void * representation_t;
 
+/**
+ * Handle of incremental AML(XML) parser
+ */
+typedef void * amlParserHandle_t;
+
+/**
+ * Handle of iterator over AMLObjects of a batch
+ */
+typedef void * amlBatchIterator_t;
+
+/**
+ * Handle of queue of CAMLCompletion, which can be polled by its file descriptor
+ */
+typedef void * amlCompletionQueue_t;
+
+/**
+ * Handle of pipeline which builds, validates, serializes and delivers AMLObjects on its own threads
+ */
+typedef void * amlPipeline_t;
+
 
 /**
  * @brief       Create an instance of Representation.
@@ -50,6 +215,119 @@ typedef void * representation_t;
 AML_EXPORT CAMLErrorCode CreateRepresentation(const char* filePath,
                                               representation_t* repHandle);
 
+/**
+ * @brief       Create an instance of Representation from AML data model in memory.
+ * @param       buffer          [in] AML document that contains data model information.
+ * @param       size            [in] size of 'buffer' in bytes.
+ * @param       repHandle       [out] handle of created Representation.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_AML_SCHEMA    Invalid AML document.
+ * @retval      #CAML_INVALID_FILE_PATH Neither a file in memory nor a temporary file can be made for the document.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        'buffer' does not need to be null-terminated, and it can be freed right after this call.
+ *              The document is loaded through a file in memory, or through a temporary file in $TMPDIR or /tmp,
+ *              which is removed right after loading, if the system has no memfd_create() or /proc.
+ *              To destroy an instance, use DestroyRepresentation().
+ */
+AML_EXPORT CAMLErrorCode CreateRepresentationFromBuffer(const char* buffer,
+                                                        const size_t size,
+                                                        representation_t* repHandle);
+
+/**
+ * @brief       Create an instance of Representation which loads SystemUnitClasses of data model on first use.
+ * @param       filePath        [in] path of an AML file that contains data model information.
+ * @param       repHandle       [out] handle of created Representation.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_FILE_PATH Invalid file path.
+ * @retval      #CAML_INVALID_AML_SCHEMA    Invalid AML document.
+ * @retval      #CAML_INVALID_XML_STR   Broken XML document.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        Only the offsets of SystemUnitClasses are indexed at first, and a SystemUnitClass is loaded
+ *              when AMLData of its name is converted by Representation_AmlToData() or Representation_DataToByte().
+ *              SystemUnitClasses of the same name in different SystemUnitClassLibs are loaded together.
+ *              Representation_ByteToData() and conversions to AML(XML) string load all of them, so that
+ *              AML(XML) string has the same SystemUnitClassLib as with CreateRepresentation().
+ *              Each load parses the model again with the SystemUnitClasses loaded so far, so this suits
+ *              a large model of which only a few SystemUnitClasses are used.
+ *              The file is mapped to memory until the instance is destroyed, so it should not be modified.
+ *              To destroy an instance, use DestroyRepresentation().
+ */
+AML_EXPORT CAMLErrorCode CreateLazyRepresentation(const char* filePath,
+                                                  representation_t* repHandle);
+
+/**
+ * @brief       Create a handle of Representation that shares the data model loaded from the same file.
+ * @param       filePath        [in] path of an AML file that contains data model information.
+ * @param       repHandle       [out] handle of Representation.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_FILE_PATH Invalid file path.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        The data model is parsed only once per process for a file, which is identified by its real path.
+ *              Each call returns a new handle, which should be deleted after use by DestroyRepresentation().
+ *              The data model is released when the last handle sharing it is destroyed.
+ *              Changes of the file are not loaded while the data model is shared.
+ */
+AML_EXPORT CAMLErrorCode CreateSharedRepresentation(const char* filePath,
+                                                    representation_t* repHandle);
+
+/**
+ * @brief       Create a handle of Representation that shares the data model loaded from the same content.
+ * @param       buffer          [in] AML document that contains data model information.
+ * @param       size            [in] size of 'buffer' in bytes.
+ * @param       repHandle       [out] handle of Representation.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_AML_SCHEMA    Invalid AML document.
+ * @retval      #CAML_INVALID_FILE_PATH Neither a file in memory nor a temporary file can be made for the document.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        The data model is parsed only once per process for the same content, which is compared byte by byte.
+ *              The document is kept with the data model.
+ *              Each call returns a new handle, which should be deleted after use by DestroyRepresentation().
+ */
+AML_EXPORT CAMLErrorCode CreateSharedRepresentationFromBuffer(const char* buffer,
+                                                              const size_t size,
+                                                              representation_t* repHandle);
+
+/**
+ * @brief       This function replaces the data model of Representation with the one loaded from a file.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       filePath        [in] path of an AML file that contains data model information.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_INVALID_FILE_PATH Invalid file path.
+ * @retval      #CAML_INVALID_AML_SCHEMA    Invalid AML document.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        Other threads can keep converting data with the handle while the new data model is loaded.
+ *              Calls which have started before the replacement finish with the old data model,
+ *              and it is released when the last of them returns.
+ *              If loading fails, the current data model is kept.
+ *              Representation created by CreateLazyRepresentation() stays lazy.
+ *              Other handles sharing the data model by CreateSharedRepresentation() are not affected.
+ */
+AML_EXPORT CAMLErrorCode Representation_Reload(representation_t repHandle,
+                                               const char* filePath);
+
+/**
+ * @brief       This function replaces the data model of Representation with AML data model in memory.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       buffer          [in] AML document that contains data model information.
+ * @param       size            [in] size of 'buffer' in bytes.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_INVALID_AML_SCHEMA    Invalid AML document.
+ * @retval      #CAML_INVALID_FILE_PATH Neither a file in memory nor a temporary file can be made for the document.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        See Representation_Reload().
+ */
+AML_EXPORT CAMLErrorCode Representation_ReloadFromBuffer(representation_t repHandle,
+                                                         const char* buffer,
+                                                         const size_t size);
+
 /**
  * @brief       Destroy an instance of Representation.
  * @param       repHandle       [in] handle of Representation that will be destroyed.
@@ -73,6 +351,19 @@ AML_EXPORT CAMLErrorCode DestroyRepresentation(representation_t repHandle);
 AML_EXPORT CAMLErrorCode Representation_GetRepId(const representation_t repHandle,
                                                  char** repId);
 
+/**
+ * @brief       This function gets the number of SystemUnitClass names loaded by Representation of CreateLazyRepresentation().
+ * @param       repHandle       [in] handle of Representation.
+ * @param       loaded          [out] the number of SystemUnitClass names loaded so far.
+ * @param       total           [out] the number of SystemUnitClass names in data model.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle, or Representation which is not created by CreateLazyRepresentation().
+ */
+AML_EXPORT CAMLErrorCode Representation_GetLoadedClassCount(const representation_t repHandle,
+                                                            size_t* loaded,
+                                                            size_t* total);
+
 /**
  * @brief       This function returns AMLObject that contains configuration data which is present in RoleClassLib.
  * @param       repHandle       [in] handle of Representation.
@@ -88,6 +379,44 @@ AML_EXPORT CAMLErrorCode Representation_GetRepId(const representation_t repHandl
 AML_EXPORT CAMLErrorCode Representation_GetConfigInfo(const representation_t repHandle,
                                                       amlObjectHandle_t* amlObjHandle);
 
+/**
+ * @brief       This function returns AMLObject of configuration data, which is shared by all callers of the data model.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandle    [out] handle of AMLObject.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @note        Configuration data is read once per data model, and later calls return the same handle.
+ *              The AMLObject is frozen (See AMLObject_Freeze()) and owned by the data model,
+ *              so it must not be destroyed; DestroyAMLObject() fails with #CAML_INVALID_HANDLE.
+ *              It is valid until the Representation is destroyed or reloaded: the handle is released
+ *              with the old data model, when the calls which have started before it return.
+ *              So it must not be used while another thread may reload or destroy the Representation,
+ *              and it should be got again after a reload, since a released handle can be reused by another AMLObject.
+ *              Use Representation_GetConfigInfo() for a copy which outlives the data model.
+ * @see         Representation_GetConfigInfo
+ */
+AML_EXPORT CAMLErrorCode Representation_GetSharedConfigInfo(const representation_t repHandle,
+                                                            amlObjectHandle_t* amlObjHandle);
+
+/**
+ * @brief       This function gets the "cycle" value of configuration data as a number.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       name            [in] name of AMLData in configuration data (RoleClass name).
+ * @param       cycle           [out] cycle value, or #CAML_CYCLE_ONCE for "once".
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_KEY_NOT_EXIST      'name' has no cycle, or it is not a number nor "once".
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ */
+AML_EXPORT CAMLErrorCode Representation_GetCycle(const representation_t repHandle,
+                                                 const char* name,
+                                                 int64_t* cycle);
+
 /**
  * @brief       This function converts AMLObject to AML(XML) string to match the AML model information which is set on CreateRepresentation().
  * @param       repHandle       [in] handle of Representation.
@@ -115,12 +444,95 @@ AML_EXPORT CAMLErrorCode Representation_DataToAml(const representation_t repHand
  * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
  * @note        AMLObject instance will be allocated, so it should be deleted after use.
  *              To destroy an instance, use DestroyAMLObject().
+ *              Each call allocates a new AMLObject, as datamodel-aml-cpp does;
+ *              decoding into an existing AMLObject to reuse its memory is not supported.
  * @see         DestroyAMLObject
  */
 AML_EXPORT CAMLErrorCode Representation_AmlToData(const representation_t repHandle,
                                                   const char* amlStr,
                                                   amlObjectHandle_t* amlObjHandle);
 
+/**
+ * @brief       This function scans AML(XML) string and passes its AMLData to a callback as events, without creating AMLObject.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlStr          [in] AML(XML) string, as made by Representation_DataToAml().
+ * @param       size            [in] size of 'amlStr' in bytes. It does not need to be null-terminated.
+ * @param       callback        [in] callback which is called for each event, in order.
+ * @param       userData        [in] user data passed to 'callback'.
+ * @retval      #CAML_OK                 Successful, or stopped by 'callback'.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_INVALID_XML_STR    Invalid AML(XML) string.
+ * @retval      #CAML_INVALID_AML_SCHEMA 'amlStr' has no InstanceHierarchy of AMLObject.
+ * @note        Keys and values of an event are valid only during the callback.
+ *              Events are passed as the string is scanned, so a callback can stop once it has the values it needs.
+ *              Unlike Representation_AmlToData(), AMLData is not validated against the data model.
+ * @see         CAMLParseEventType
+ */
+AML_EXPORT CAMLErrorCode Representation_AmlParseEvents(const representation_t repHandle,
+                                                       const char* amlStr,
+                                                       size_t size,
+                                                       CAMLParseCallback callback,
+                                                       void* userData);
+
+/**
+ * @brief       This function creates a parser which converts AML(XML) string given in parts to AMLObject.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       parser          [out] handle of parser.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ * @note        Parts are passed by AmlParser_Feed(), and AMLObject is taken by AmlParser_Finish().
+ *              Then the parser is ready for the next AML(XML) string.
+ *              A parser should be used by one thread at a time.
+ *              To destroy an instance, use DestroyAmlParser().
+ */
+AML_EXPORT CAMLErrorCode Representation_AmlParserCreate(const representation_t repHandle,
+                                                        amlParserHandle_t* parser);
+
+/**
+ * @brief       This function parses a part of AML(XML) string.
+ * @param       parser          [in] handle of parser.
+ * @param       chunk           [in] part of AML(XML) string, which follows the parts given before.
+ * @param       size            [in] size of 'chunk' in bytes.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_XML_STR    Invalid AML(XML) string.
+ * @retval      #CAML_INVALID_AML_SCHEMA Invalid AML(XML) string.
+ * @note        'chunk' is parsed right away, and it can be freed after this call.
+ *              Only a token which is cut at the end of 'chunk' is kept until the next part.
+ *              Once an error is returned, the AML(XML) string is discarded when AmlParser_Finish() is called.
+ */
+AML_EXPORT CAMLErrorCode AmlParser_Feed(amlParserHandle_t parser,
+                                        const char* chunk,
+                                        size_t size);
+
+/**
+ * @brief       This function finishes AML(XML) string given to a parser and converts it to AMLObject.
+ * @param       parser          [in] handle of parser.
+ * @param       amlObjHandle    [out] handle of AMLObject.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_XML_STR    Invalid or incomplete AML(XML) string.
+ * @retval      #CAML_INVALID_AML_SCHEMA AML(XML) string has no AMLObject.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @note        The parser is reset whether it succeeds or not.
+ *              Unlike Representation_AmlToData(), AMLData is not validated against the data model.
+ *              AMLObject instance will be allocated, so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLObject().
+ */
+AML_EXPORT CAMLErrorCode AmlParser_Finish(amlParserHandle_t parser,
+                                          amlObjectHandle_t* amlObjHandle);
+
+/**
+ * @brief       Destroy an instance of parser.
+ * @param       parser          [in] handle of parser.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ */
+AML_EXPORT CAMLErrorCode DestroyAmlParser(amlParserHandle_t parser);
+
 /**
  * @brief       This function converts AMLObject to Protobuf byte data to match the AML model information which is set on CreateRepresentation().
  * @param       repHandle       [in] handle of Representation.
@@ -141,6 +553,69 @@ AML_EXPORT CAMLErrorCode Representation_DataToByte(const representation_t repHan
                                                    uint8_t** byte, 
                                                    size_t* size);
 
+/**
+ * @brief       This function converts AMLObject to AML(XML) string into a buffer of the caller.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       buffer          [out] buffer to write null-terminated AML(XML) string. It can be NULL if 'bufferSize' is 0.
+ * @param       bufferSize      [in] size of 'buffer' in bytes.
+ * @param       size            [out] size of AML(XML) string including the terminating null character.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_BUFFER_TOO_SMALL   'buffer' is smaller than 'size', and nothing is written to it.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @note        'size' is set even if #CAML_BUFFER_TOO_SMALL is returned, so a retry with a buffer of 'size' succeeds.
+ * @see         Representation_DataToAml
+ */
+AML_EXPORT CAMLErrorCode Representation_DataToAmlBuffer(const representation_t repHandle,
+                                                        const amlObjectHandle_t amlObjHandle,
+                                                        char* buffer,
+                                                        size_t bufferSize,
+                                                        size_t* size);
+
+/**
+ * @brief       This function converts AMLObject to Protobuf byte data into a buffer of the caller.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       buffer          [out] buffer to write byte data. It can be NULL if 'bufferSize' is 0.
+ * @param       bufferSize      [in] size of 'buffer' in bytes.
+ * @param       size            [out] size of byte data.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_BUFFER_TOO_SMALL   'buffer' is smaller than 'size', and nothing is written to it.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @retval      #CAML_API_NOT_ENABLED    If datamodel-aml-cpp library is built with 'disable_protobuf' option, this API will be disabled.
+ * @note        'size' is set even if #CAML_BUFFER_TOO_SMALL is returned, so a retry with a buffer of 'size' succeeds.
+ * @see         Representation_DataToByte
+ */
+AML_EXPORT CAMLErrorCode Representation_DataToByteBuffer(const representation_t repHandle,
+                                                         const amlObjectHandle_t amlObjHandle,
+                                                         uint8_t* buffer,
+                                                         size_t bufferSize,
+                                                         size_t* size);
+
+/**
+ * @brief       This function gets the exact size of AMLObject converted to the given format.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       format          [in] format to convert to.
+ * @param       size            [out] size of converted data, which Representation_DataToAmlBuffer()
+ *                                    or Representation_DataToByteBuffer() needs.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @retval      #CAML_API_NOT_ENABLED    If datamodel-aml-cpp library is built with 'disable_protobuf' option, this API will be disabled.
+ * @note        The size is measured by converting AMLObject, so it costs as much as a conversion.
+ *              To convert only once, call the buffer API with a buffer of a likely size and retry on #CAML_BUFFER_TOO_SMALL.
+ */
+AML_EXPORT CAMLErrorCode Representation_GetSerializedSize(const representation_t repHandle,
+                                                          const amlObjectHandle_t amlObjHandle,
+                                                          CAMLSerialFormat format,
+                                                          size_t* size);
+
 /**
  * @brief       This function converts Protobuf byte data to AMLObject to match the AML model information which is set on CreateRepresentation().
  * @param       repHandle       [in] handle of Representation.
@@ -154,12 +629,374 @@ AML_EXPORT CAMLErrorCode Representation_DataToByte(const representation_t repHan
  * @retval      #CAML_API_NOT_ENABLED    If datamodel-aml-cpp library is built with 'disable_protobuf' option, this API will be disabled.
  * @note        AMLObject instance will be allocated, so it should be deleted after use.
  *              To destroy an instance, use DestroyAMLObject().
+ *              Each call allocates a new AMLObject, as datamodel-aml-cpp does;
+ *              decoding into an existing AMLObject to reuse its memory is not supported.
  * @see         DestroyAMLObject
  */
 AML_EXPORT CAMLErrorCode Representation_ByteToData(const representation_t repHandle,
                                                    const uint8_t* byte,
                                                    const size_t size,
                                                    amlObjectHandle_t* amlObjHandle);
+
+/**
+ * @brief       This function converts AMLObjects to one frame of Protobuf byte data.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandles   [in] array of AMLObject handles.
+ * @param       count           [in] the number of AMLObjects in 'amlObjHandles'.
+ * @param       byte            [out] frame of byte data.
+ * @param       size            [out] size of the frame.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @retval      #CAML_API_NOT_ENABLED    If datamodel-aml-cpp library is built with 'disable_protobuf' option, this API will be disabled.
+ * @note        The frame has the ID of Representation, the count, each AMLObject prefixed by its varint length
+ *              and CRC-32C of all of them. It is read by Representation_ByteToDataBatch().
+ *              Byte data will be allocated to 'byte', so it should be freed after use.
+ *              ex) free(byte);
+ */
+AML_EXPORT CAMLErrorCode Representation_DataToByteBatch(const representation_t repHandle,
+                                                        const amlObjectHandle_t* amlObjHandles,
+                                                        const size_t count,
+                                                        uint8_t** byte,
+                                                        size_t* size);
+
+/**
+ * @brief       This function creates an iterator which converts AMLObjects of a frame one at a time.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       byte            [in] frame made by Representation_DataToByteBatch().
+ * @param       size            [in] size of the frame.
+ * @param       iterator        [out] handle of iterator.
+ * @retval      #CAML_OK                     Successful.
+ * @retval      #CAML_INVALID_PARAM          Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE         Invalid handle.
+ * @retval      #CAML_INVALID_BYTE_STR       Broken frame, or checksum mismatch.
+ * @retval      #CAML_NOT_MATCH_TO_AML_MODEL The frame is made by Representation of other ID.
+ * @retval      #CAML_NO_MEMORY              Failed to alloc memory.
+ * @note        The frame is checked as a whole, but AMLObjects are converted by AMLBatchIterator_Next().
+ *              'byte' is not copied, so it should be kept until the iterator is destroyed.
+ *              To destroy an instance, use DestroyAMLBatchIterator().
+ */
+AML_EXPORT CAMLErrorCode Representation_ByteToDataBatch(const representation_t repHandle,
+                                                        const uint8_t* byte,
+                                                        const size_t size,
+                                                        amlBatchIterator_t* iterator);
+
+/**
+ * @brief       This function converts AMLObjects to one AML(XML) document.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandles   [in] array of AMLObject handles.
+ * @param       count           [in] the number of AMLObjects in 'amlObjHandles'.
+ * @param       amlStr          [out] AML(XML) document.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @retval      #CAML_INVALID_AML_SCHEMA The AML, which is set by CreateRepresentation, has a invalid schema.
+ * @note        Each AMLObject is an InstanceHierarchy of the document, in the order of 'amlObjHandles'.
+ *              Other sections such as RoleClassLib and SystemUnitClassLib are written only once.
+ *              InstanceHierarchies keep the name given by Representation, so the same name appears once per AMLObject,
+ *              which CAEX tools that require unique names may reject. It is read by Representation_AmlToDataBatch().
+ *              AML string will be allocated to 'amlStr', so it should be freed after use.
+ *              ex) free(amlStr);
+ */
+AML_EXPORT CAMLErrorCode Representation_DataToAmlBatch(const representation_t repHandle,
+                                                       const amlObjectHandle_t* amlObjHandles,
+                                                       const size_t count,
+                                                       char** amlStr);
+
+/**
+ * @brief       This function creates an iterator which converts InstanceHierarchies of AML document one at a time.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlStr          [in] AML(XML) document, as made by Representation_DataToAmlBatch().
+ * @param       iterator        [out] handle of iterator.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_INVALID_XML_STR    Broken XML before CAEXFile.
+ * @retval      #CAML_INVALID_AML_SCHEMA There is no CAEXFile.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @note        The document is read only as far as AMLBatchIterator_Next() or AMLBatchIterator_GetCount() needs,
+ *              so a broken part is reported by them, as #CAML_INVALID_AML_SCHEMA for a document
+ *              which ends in an InstanceHierarchy or before the end tag of CAEXFile.
+ *              A document of one AMLObject, as made by Representation_DataToAml(), is a batch of one.
+ *              'amlStr' is not copied, so it should be kept until the iterator is destroyed.
+ *              To destroy an instance, use DestroyAMLBatchIterator().
+ */
+AML_EXPORT CAMLErrorCode Representation_AmlToDataBatch(const representation_t repHandle,
+                                                       const char* amlStr,
+                                                       amlBatchIterator_t* iterator);
+
+/**
+ * @brief       This function gets the number of AMLObjects in a batch.
+ * @param       iterator        [in] handle of iterator.
+ * @param       count           [out] the number of AMLObjects.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_XML_STR   Broken AML document of Representation_AmlToDataBatch().
+ */
+AML_EXPORT CAMLErrorCode AMLBatchIterator_GetCount(const amlBatchIterator_t iterator,
+                                                   size_t* count);
+
+/**
+ * @brief       This function converts the next AMLObject of a batch.
+ * @param       iterator        [in] handle of iterator.
+ * @param       amlObjHandle    [out] handle of AMLObject.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_END_OF_BATCH       All AMLObjects are converted.
+ * @retval      $CAML_INVALID_BYTE_STR   Invalid protobuf byte string.
+ * @retval      #CAML_INVALID_XML_STR    Invalid AML string.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @note        AMLObject instance will be allocated, so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLObject().
+ */
+AML_EXPORT CAMLErrorCode AMLBatchIterator_Next(amlBatchIterator_t iterator,
+                                               amlObjectHandle_t* amlObjHandle);
+
+/**
+ * @brief       Destroy an instance of batch iterator.
+ * @param       iterator        [in] handle of iterator.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLBatchIterator(amlBatchIterator_t iterator);
+
+/**
+ * @brief       This function converts AMLObject to Protobuf byte data on a thread of the library.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       amlObjHandle    [in] handle of AMLObject.
+ * @param       callback        [in] callback to receive the result.
+ * @param       userData        [in] user data which is given back in CAMLCompletion.
+ * @retval      #CAML_OK                The conversion is queued.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory, or to start a thread.
+ * @note        Errors of the conversion itself are given to 'callback', as the error codes of Representation_DataToByte().
+ *              The handle is looked up when the conversion runs on a pool thread, not when this function returns,
+ *              so the handle must stay alive, and AMLObject should not be changed or destroyed,
+ *              until 'callback' is called.
+ *              Byte data in CAMLCompletion is allocated, so it should be freed after use. ex) free(completion->byte);
+ *              Conversions run on the threads of Representation_ConvertBatch().
+ */
+AML_EXPORT CAMLErrorCode Representation_DataToByteAsync(const representation_t repHandle,
+                                                        const amlObjectHandle_t amlObjHandle,
+                                                        CAMLCompletionCallback callback,
+                                                        void* userData);
+
+/**
+ * @brief       This function converts Protobuf byte data to AMLObject on a thread of the library.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       byte            [in] byte data.
+ * @param       size            [in] size of byte data.
+ * @param       callback        [in] callback to receive the result.
+ * @param       userData        [in] user data which is given back in CAMLCompletion.
+ * @retval      #CAML_OK                The conversion is queued.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory, or to start a thread.
+ * @note        'byte' is copied, so it can be freed when this function returns.
+ *              Errors of the conversion itself are given to 'callback', as the error codes of Representation_ByteToData().
+ *              AMLObject in CAMLCompletion is allocated, so it should be deleted after use by DestroyAMLObject().
+ *              Conversions run on the threads of Representation_ConvertBatch().
+ */
+AML_EXPORT CAMLErrorCode Representation_ByteToDataAsync(const representation_t repHandle,
+                                                        const uint8_t* byte,
+                                                        const size_t size,
+                                                        CAMLCompletionCallback callback,
+                                                        void* userData);
+
+/**
+ * @brief       This function creates a queue of CAMLCompletion for a thread which polls file descriptors.
+ * @param       queue           [out] created queue.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory, or to create eventfd.
+ * @note        A completion callback passes its CAMLCompletion to AMLCompletionQueue_Post(),
+ *              and the polling thread takes it by AMLCompletionQueue_Pop() when the descriptor is readable.
+ *              The queue should be deleted after use by DestroyAMLCompletionQueue().
+ */
+AML_EXPORT CAMLErrorCode CreateAMLCompletionQueue(amlCompletionQueue_t* queue);
+
+/**
+ * @brief       This function destroys a queue of CAMLCompletion.
+ * @param       queue           [in] queue to destroy.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @note        Results still in the queue are not freed. No conversion should post to the queue any more.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLCompletionQueue(amlCompletionQueue_t queue);
+
+/**
+ * @brief       This function gets a file descriptor which is readable while the queue is not empty.
+ * @param       queue           [in] queue of CAMLCompletion.
+ * @param       fd              [out] file descriptor, which is owned by the queue.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ */
+AML_EXPORT CAMLErrorCode AMLCompletionQueue_GetFd(amlCompletionQueue_t queue, int* fd);
+
+/**
+ * @brief       This function adds a copy of CAMLCompletion at the tail of queue.
+ * @param       queue           [in] queue of CAMLCompletion.
+ * @param       completion      [in] result of a conversion.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory.
+ */
+AML_EXPORT CAMLErrorCode AMLCompletionQueue_Post(amlCompletionQueue_t queue, const CAMLCompletion* completion);
+
+/**
+ * @brief       This function takes CAMLCompletion from the head of queue.
+ * @param       queue           [in] queue of CAMLCompletion.
+ * @param       completion      [out] result of a conversion.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @retval      #CAML_QUEUE_EMPTY       Queue is empty.
+ */
+AML_EXPORT CAMLErrorCode AMLCompletionQueue_Pop(amlCompletionQueue_t queue, CAMLCompletion* completion);
+
+/**
+ * @brief       This function creates a pipeline of AMLObjects and starts its threads.
+ * @param       repHandle       [in] handle of Representation which serializes AMLObjects.
+ * @param       config          [in] callbacks, threads and queues of the pipeline.
+ * @param       pipeline        [out] handle of pipeline.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter, or 'build' or 'sink' is missing.
+ * @retval      #CAML_INVALID_HANDLE    Invalid handle.
+ * @retval      #CAML_NO_MEMORY         Failed to alloc memory, or to start a thread.
+ * @note        Each thread of a stage has a queue of its own, and items of a device always go to the same thread
+ *              of each stage, so that they are delivered in the order they are pushed.
+ *              The AMLObject made by 'build' belongs to the pipeline, which destroys it after serialization.
+ *              Data given to 'sink' is valid only during the callback.
+ *              The pipeline should be deleted after use by DestroyAMLPipeline().
+ */
+AML_EXPORT CAMLErrorCode CreateAMLPipeline(const representation_t repHandle,
+                                           const CAMLPipelineConfig* config,
+                                           amlPipeline_t* pipeline);
+
+/**
+ * @brief       This function delivers the items in the pipeline and destroys it.
+ * @param       pipeline        [in] handle of pipeline.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @note        Items already pushed go through all stages before this function returns.
+ *              No thread should push to the pipeline during this call.
+ */
+AML_EXPORT CAMLErrorCode DestroyAMLPipeline(amlPipeline_t pipeline);
+
+/**
+ * @brief       This function adds a record to the pipeline, to be built into AMLObject.
+ * @param       pipeline        [in] handle of pipeline.
+ * @param       deviceId        [in] device of the record, which keeps the order of its records.
+ * @param       record          [in] record given to 'build' callback.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @note        With CAML_BACKPRESSURE_BLOCK, it waits while the queue of the build stage is full,
+ *              so it should not be called by the callbacks of the same pipeline.
+ *              A record is given either to 'build' or to 'discard' callback.
+ */
+AML_EXPORT CAMLErrorCode AMLPipeline_Push(amlPipeline_t pipeline,
+                                          const char* deviceId,
+                                          void* record);
+
+/**
+ * @brief       This function gets the counters and queue depth of a stage.
+ * @param       pipeline        [in] handle of pipeline.
+ * @param       stage           [in] stage of pipeline.
+ * @param       metrics         [out] metrics of the stage.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ * @note        The counters are read one by one while the pipeline runs, so they may not add up exactly.
+ */
+AML_EXPORT CAMLErrorCode AMLPipeline_GetMetrics(const amlPipeline_t pipeline,
+                                                const CAMLPipelineStage stage,
+                                                CAMLPipelineStageMetrics* metrics);
+
+/**
+ * @brief       This function runs the same conversion over an array of items, on threads of the library.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       type            [in] conversion, which tells the input and output fields of 'items'.
+ * @param       items           [in,out] array of conversions. 'result' of each item is set to its error code.
+ * @param       count           [in] the number of items.
+ * @retval      #CAML_OK                 All items are converted.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory, or to start a thread.
+ * @retval      Others                   'result' of the first item which failed.
+ * @note        Items are split in chunks over a pool of threads, whose idle threads take the chunks left to others.
+ *              The calling thread converts items too, until all of them are done.
+ *              Outputs of the items which succeeded are allocated even if others failed,
+ *              so they should be freed or destroyed as outputs of the single conversion.
+ *              ex) free(items[i].aml); DestroyAMLObject(items[i].amlObj);
+ *              If it returns #CAML_NO_MEMORY, AMLObjects of *ToData conversions are not given to the caller.
+ *              AMLObjects of DataTo* conversions should not be changed or destroyed by other threads during this call.
+ *              Handles are looked up and registered once for all items, so the lock of the handle registry,
+ *              which is shared with the other APIs, is taken once per call instead of once per item.
+ */
+AML_EXPORT CAMLErrorCode Representation_ConvertBatch(const representation_t repHandle,
+                                                     const CAMLConvertType type,
+                                                     CAMLConvertItem* items,
+                                                     const size_t count);
+
+/**
+ * @brief       This function sets the number of threads of Representation_ConvertBatch().
+ * @param       threads         [in] the number of threads, or 0 for the number of cores.
+ * @retval      #CAML_OK                Successful.
+ * @note        Threads are started on the next conversion. Conversions in progress finish on the threads they started on.
+ */
+AML_EXPORT CAMLErrorCode SetConvertThreadCount(const size_t threads);
+
+/**
+ * @brief       This function gets the number of threads of Representation_ConvertBatch().
+ * @param       threads         [out] the number of threads.
+ * @retval      #CAML_OK                Successful.
+ * @retval      #CAML_INVALID_PARAM     Invalid parameter.
+ */
+AML_EXPORT CAMLErrorCode GetConvertThreadCount(size_t* threads);
+
+/**
+ * @brief       This function converts AMLPatch to byte data.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       patch           [in] handle of AMLPatch.
+ * @param       byte            [out] byte data.
+ * @param       size            [out] size of byte data.
+ * @retval      #CAML_OK                 Successful.
+ * @retval      #CAML_INVALID_PARAM      Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE     Invalid handle.
+ * @retval      #CAML_NO_MEMORY          Failed to alloc memory.
+ * @note        Byte data contains ID of Representation, so it can be converted only by a Representation of the same AML model.
+ *              Characters will be allocated to 'byte', so it should be freed after use. (See the below example)
+ *              ex) free(byte);
+ * @see         AMLObject_Diff
+ */
+AML_EXPORT CAMLErrorCode Representation_PatchToByte(const representation_t repHandle,
+                                                    const amlPatchHandle_t patch,
+                                                    uint8_t** byte,
+                                                    size_t* size);
+
+/**
+ * @brief       This function converts byte data made by Representation_PatchToByte() to AMLPatch.
+ * @param       repHandle       [in] handle of Representation.
+ * @param       byte            [in] byte data.
+ * @param       size            [in] size of byte data.
+ * @param       patch           [out] handle of AMLPatch.
+ * @retval      #CAML_OK                     Successful.
+ * @retval      #CAML_INVALID_PARAM          Invalid parameter.
+ * @retval      #CAML_INVALID_HANDLE         Invalid handle.
+ * @retval      #CAML_INVALID_BYTE_STR       Invalid byte data.
+ * @retval      #CAML_NOT_MATCH_TO_AML_MODEL Byte data was made by a Representation of another AML model.
+ * @retval      #CAML_NO_MEMORY              Failed to alloc memory.
+ * @note        AMLPatch instance will be allocated, so it should be deleted after use.
+ *              To destroy an instance, use DestroyAMLPatch().
+ * @see         AMLObject_ApplyPatch
+ */
+AML_EXPORT CAMLErrorCode Representation_ByteToPatch(const representation_t repHandle,
+                                                    const uint8_t* byte,
+                                                    const size_t size,
+                                                    amlPatchHandle_t* patch);
+
 #ifdef __cplusplus
 }
 #endif
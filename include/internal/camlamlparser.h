@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_AML_PARSER_H_
+#define C_AML_AML_PARSER_H_
+
+#include <stddef.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AMLInterface.h"
+#include "camlrepresentation.h"
+#include "camlxmlscanner.h"
+
+/**
+ * Turns tokens of InstanceHierarchy in AML document, as written by Representation::DataToAml(), into parse events.
+ * Other sections of the document are skipped. Nothing is validated against the data model.
+ * Keys and values of events point into the parser, so they are valid only during the handler.
+ */
+class AmlEventParser
+{
+public:
+    // Returns false to stop parsing.
+    typedef std::function<bool(const CAMLParseEvent&)> Handler;
+
+    explicit AmlEventParser(const Handler& handler);
+
+    // Returns false if the handler stopped parsing. Throws AMLException on a broken document.
+    bool parse(const XmlToken& token);
+
+    // Throws AMLException if the document is not complete.
+    void finish() const;
+
+private:
+    typedef enum
+    {
+        ATTRIBUTE_UNKNOWN = 0,  // no Value or child Attribute yet
+        ATTRIBUTE_VALUE,
+        ATTRIBUTE_ARRAY,
+        ATTRIBUTE_NESTED
+    } AttributeKind;
+
+    typedef struct
+    {
+        size_t keyOffset;       // key is kept in 'm_keys' from this offset to the end of the next frame
+        AttributeKind kind;
+    } AttributeFrame;
+
+    bool startElement(const XmlToken& token);
+    bool endElement(const char* name, size_t nameSize);
+    bool startAttribute(const XmlToken& token);
+    bool endAttribute();
+    bool emit(CAMLParseEventType type, size_t keyOffset, size_t keyEnd, const std::string* value);
+    bool inData() const;
+
+    Handler m_handler;
+    bool m_seenInstanceHierarchy;
+    bool m_inInstanceHierarchy;
+    size_t m_elementDepth;                  // depth of InternalElement in InstanceHierarchy
+    size_t m_dataKeyOffset;                 // key of AMLData being parsed in 'm_keys'
+    std::vector<AttributeFrame> m_attributes;
+    std::string m_keys;                     // keys of AMLData and Attributes being parsed, one after another
+    bool m_inValue;
+    std::string m_value;
+};
+
+// Returns false if the handler stopped parsing. Throws AMLException on a broken document.
+bool ParseAmlEvents(const char* data, size_t size, const AmlEventParser::Handler& handler);
+
+/**
+ * Builds AMLObject from parse events of AmlEventParser.
+ */
+class AmlObjectBuilder
+{
+public:
+    AmlObjectBuilder();
+
+    // Throws AMLException on an event out of order.
+    bool onEvent(const CAMLParseEvent& event);
+
+    // Throws AMLException if the header of AMLObject is missing.
+    AML::AMLObject* build() const;
+
+private:
+    std::string m_deviceId;
+    std::string m_timeStamp;
+    std::string m_id;
+    std::vector<std::pair<std::string, AML::AMLData> > m_datas;
+    std::vector<std::pair<std::string, AML::AMLData> > m_nested;    // AMLData being built, innermost last
+    bool m_inArray;
+    std::string m_arrayKey;
+    std::vector<std::string> m_array;
+};
+
+/**
+ * Parses AML document which is given in parts, keeping only the last unfinished token between them.
+ */
+class AmlPushParser
+{
+public:
+    AmlPushParser();
+
+    // Throws AMLException on a broken document.
+    void feed(const char* data, size_t size);
+
+    // Throws AMLException if the document is broken or not complete.
+    AML::AMLObject* finish();
+
+private:
+    void parse(const char* data, size_t size, bool partial);
+
+    AmlObjectBuilder m_builder;
+    AmlEventParser m_parser;
+    std::string m_pending;      // unfinished token at the end of the last part
+};
+
+#endif // C_AML_AML_PARSER_H_
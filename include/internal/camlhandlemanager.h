@@ -18,24 +18,64 @@
 #ifndef C_AML_HANDLE_MANAGER_H_
 #define C_AML_HANDLE_MANAGER_H_
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "AMLInterface.h"
 #include "Representation.h"
 #include "camlinterface.h"
 #include "camlrepresentation.h"
+#include "camlpatch.h"
+#include "camlmodel.h"
+
+/**
+ * AMLData of an AMLObject in the order of AMLObject::getDataNames(), for access by index.
+ */
+typedef struct
+{
+    std::vector<std::string> names;
+    std::vector<const AML::AMLData*> datas;
+    mutable std::vector<amlDataHandle_t> handles;   // resolved by ResolveAmlDataHandle(), NULL until then
+} AmlDataIndex;
 
 amlObjectHandle_t AddAmlObjHandle(AML::AMLObject* amlObj, bool needsDelete);
+bool AddAmlObjHandles(size_t count, const std::function<void(size_t, void*)>& construct, amlObjectHandle_t* handles);
+// Adds handles of 'count' AMLObjects under one lock, skipping NULL ones. Returns false, adding none, if memory is not enough.
+bool AddAmlObjHandles(AML::AMLObject* const* amlObjs, size_t count, bool needsDelete, amlObjectHandle_t* handles);
 void RemoveAmlObj(amlObjectHandle_t handle);
+bool RemoveAmlObjs(amlObjectHandle_t* handles, size_t count);
 AML::AMLObject* FindAmlObj(amlObjectHandle_t handle);
+// Finds AMLObjects of 'count' handles under one lock, NULL for a handle which is not found. Throws std::bad_alloc.
+void FindAmlObjs(const amlObjectHandle_t* handles, size_t count, AML::AMLObject** amlObjs);
+size_t GetAmlObjHandleSize(void);
+const AmlDataIndex* GetAmlDataIndex(amlObjectHandle_t handle);
+void ResetAmlDataIndex(amlObjectHandle_t handle);
+// Returns the handle of AMLData at 'position' of 'index', which is registered on first use and cached in 'index'.
+amlDataHandle_t ResolveAmlDataHandle(const AmlDataIndex* index, size_t position);
+bool FreezeAmlObj(amlObjectHandle_t handle);
+bool IsAmlObjFrozen(amlObjectHandle_t handle);
+void PinAmlObj(amlObjectHandle_t handle);
+bool IsAmlObjPinned(amlObjectHandle_t handle);
 
 amlDataHandle_t AddAmlDataHandle(AML::AMLData* amlData, bool needsDelete);
 void RemoveAmlData(amlDataHandle_t handle);
-void RemoveAmlData(AML::AMLData* amlData);
+bool RemoveAmlDatas(amlDataHandle_t* handles, size_t count);
 AML::AMLData* FindAmlData(amlDataHandle_t handle);
 amlDataHandle_t* FindAmlDataHandle(AML::AMLData* amlData);
+bool IsAmlDataFrozen(amlDataHandle_t handle);
+size_t GetAmlDataHandleSize(void);
 
-representation_t AddRepresentationHandle(AML::Representation* cppRep);
+representation_t AddRepresentationHandle(const std::shared_ptr<AmlModel>& model);
 void RemoveRepresentation(representation_t handle);
-AML::Representation* FindRepresentation(representation_t handle);
+std::shared_ptr<AML::Representation> FindRepresentation(representation_t handle);
+std::shared_ptr<AmlModel> FindAmlModel(representation_t handle);
+bool ReplaceAmlModel(representation_t handle, const std::shared_ptr<AmlModel>& model);
+
+amlPatchHandle_t AddAmlPatchHandle(AMLPatch* patch);
+void RemoveAmlPatch(amlPatchHandle_t handle);
+AMLPatch* FindAmlPatch(amlPatchHandle_t handle);
 
 void RemoveOwnedAmlDataHandles(AML::AMLData* amlData);
 void RemoveOwnedAmlDataHandles(AML::AMLObject* amlObj);
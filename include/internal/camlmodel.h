@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_MODEL_H_
+#define C_AML_MODEL_H_
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "AMLInterface.h"
+#include "Representation.h"
+
+struct AmlLazyIndex;
+struct AmlConfigInfo;
+
+/**
+ * Data model of Representation handles, with the source it is loaded from.
+ * One model can be shared by several handles.
+ */
+typedef struct
+{
+    std::shared_ptr<AML::Representation> rep;   // replaced at run time, so use AcquireRepresentation()
+    std::string source;         // AML document the model is loaded from, if it is kept (See LoadAmlModelFromBuffer())
+    std::shared_ptr<AmlLazyIndex> lazy;     // set if SystemUnitClasses are loaded on demand
+    std::mutex configMtx;
+    std::shared_ptr<AmlConfigInfo> configInfo;  // built on first use, guarded by 'configMtx'
+} AmlModel;
+
+// Throws AMLException on failure.
+AmlModel* LoadAmlModel(const std::string& path);
+// The document is copied to the model only if 'keepSource', so that a shared model can be compared by its content.
+AmlModel* LoadAmlModelFromBuffer(const char* buffer, size_t size, bool keepSource);
+AmlModel* LoadLazyAmlModel(const std::string& path);
+
+/**
+ * Returns the Representation of model, which stays valid while it is used even if the model changes.
+ * For a lazy model, SystemUnitClasses needed by the AMLObject or all of them are loaded first.
+ * Classes which are loaded already are checked without a lock.
+ * Throws AMLException on failure.
+ */
+std::shared_ptr<AML::Representation> AcquireRepresentation(const AmlModel& model);
+std::shared_ptr<AML::Representation> AcquireRepresentation(AmlModel& model, const AML::AMLObject& amlObj);
+std::shared_ptr<AML::Representation> AcquireFullRepresentation(AmlModel& model);
+
+/**
+ * Converts an AML document with the Representation of model.
+ * For a lazy model, the document is searched for its SystemUnitClasses only if the conversion fails
+ * with the ones loaded, and it is converted again after they are loaded.
+ * Throws AMLException on failure.
+ */
+AML::AMLObject* ConvertAmlToData(AmlModel& model, const std::string& aml);
+
+/**
+ * Converts AMLObject to an AML document with the Representation of model.
+ * A lazy model loads all of its SystemUnitClasses first, since the document has the SystemUnitClassLib of the model.
+ * Throws AMLException on failure.
+ */
+std::string ConvertDataToAml(AmlModel& model, const AML::AMLObject& amlObj);
+
+// Gets the number of SystemUnitClass names loaded so far and in total. Returns false if model is not lazy.
+bool GetLoadedClassCount(const AmlModel& model, size_t* loaded, size_t* total);
+
+#endif // C_AML_MODEL_H_
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_PATCH_H_
+#define C_AML_PATCH_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "AMLInterface.h"
+
+typedef enum
+{
+    PATCH_OP_REMOVE = 0,
+    PATCH_OP_SET_STR,
+    PATCH_OP_SET_STRARR,
+    PATCH_OP_SET_DATA
+} AMLPatchOpType;
+
+/**
+ * One change of a patch.
+ * 'path' starts with the AMLData name of the AMLObject, followed by the keys of nested AMLData.
+ */
+typedef struct
+{
+    AMLPatchOpType type;
+    std::vector<std::string> path;
+    std::string str;
+    std::vector<std::string> strArr;
+    AML::AMLData data;
+} AMLPatchOp;
+
+/**
+ * Changes that turn one AMLObject into another one.
+ * The header (deviceId, timeStamp, id) is taken from the newer AMLObject.
+ */
+typedef struct
+{
+    std::string deviceId;
+    std::string timeStamp;
+    std::string id;
+    std::vector<AMLPatchOp> ops;
+} AMLPatch;
+
+// Throws AMLException on failure.
+AMLPatch* DiffAmlObject(const AML::AMLObject& prev, const AML::AMLObject& curr);
+AML::AMLObject* ApplyAmlPatch(const AML::AMLObject& base, const AMLPatch& patch);
+
+std::string PatchToByte(const std::string& repId, const AMLPatch& patch);
+AMLPatch* ByteToPatch(const std::string& repId, const uint8_t* byte, size_t size);
+
+#endif // C_AML_PATCH_H_
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_QUEUE_H_
+#define C_AML_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+#define CACHE_LINE_SIZE     64
+
+// A cell is free for the next lap only after it is popped, which takes at least 2 cells.
+#define QUEUE_MIN_CAPACITY  2
+
+/**
+ * Bounded multi-producer multi-consumer queue without locks.
+ * Each cell carries a sequence number which tells producers and consumers whose turn it is,
+ * so push() and pop() only contend on a single atomic position counter.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    // 'capacity' is rounded up to a power of two of at least QUEUE_MIN_CAPACITY. Throws std::bad_alloc if the cells can't be allocated,
+    // which is always the case above maxCapacity().
+    explicit BoundedQueue(size_t capacity)
+        : m_mask(RoundUpPowerOfTwo(capacity) - 1), m_cells(new Cell[m_mask + 1])
+    {
+        for (size_t i = 0; i <= m_mask; i++)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_enqueuePos.store(0, std::memory_order_relaxed);
+        m_dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    // Largest power of two of cells which fits in the address space.
+    static size_t maxCapacity()
+    {
+        size_t power = 1;
+        while (power <= SIZE_MAX / sizeof(Cell) / 2)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    // Returns false if the queue is full.
+    bool push(const T& value)
+    {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (0 == diff)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the queue is empty.
+    bool pop(T& value)
+    {
+        Cell* cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (0 == diff)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->value;
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Stops at the highest power of two of size_t, instead of overflowing to 0.
+    static size_t RoundUpPowerOfTwo(size_t size)
+    {
+        size_t power = QUEUE_MIN_CAPACITY;
+        while (power < size && power <= SIZE_MAX / 2)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    BoundedQueue(const BoundedQueue&);
+    BoundedQueue& operator=(const BoundedQueue&);
+
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    // Keep producers and consumers on different cache lines.
+    char m_pad0[CACHE_LINE_SIZE];
+    std::atomic<size_t> m_enqueuePos;
+    char m_pad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_dequeuePos;
+    char m_pad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+#endif // C_AML_QUEUE_H_
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_REP_CACHE_H_
+#define C_AML_REP_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "camlmodel.h"
+
+/**
+ * Returns the model cached for 'key', or the one made by 'load' which is then cached.
+ * A cached model is returned only if 'matches' accepts it, so that a key which is a hash can collide.
+ * A model loaded after a collision is not cached, and the cached one is kept for its users.
+ * The cache only keeps weak references, so a model is released when the last handle of it is destroyed.
+ * Throws AMLException if 'load' fails.
+ */
+std::shared_ptr<AmlModel> GetSharedAmlModel(const std::string& key,
+                                           const std::function<AmlModel*(void)>& load,
+                                           const std::function<bool(const AmlModel&)>& matches = nullptr);
+
+#endif // C_AML_REP_CACHE_H_
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_THREAD_POOL_H_
+#define C_AML_THREAD_POOL_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Pool of worker threads, each with a queue of its own.
+ * A worker takes the newest task of its own queue first, and steals the oldest task of other queues when it runs out.
+ * Workers keep the pool alive, so it is destroyed by the last of them after shutdown().
+ * Tasks should not throw.
+ */
+class AmlThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    // Use Create(), since workers share the ownership of the pool. Throws std::system_error if a thread fails to start.
+    static std::shared_ptr<AmlThreadPool> Create(size_t threads);
+
+    size_t size() const;
+
+    // Returns false if the pool is shut down. A task submitted by a worker goes to the queue of the worker.
+    bool submit(const Task& task);
+
+    // Calls 'body' for each index in [0, count), in chunks on workers. The calling thread runs tasks until all are done.
+    // If a chunk can't be queued, the exception is thrown after the queued chunks are done, and the rest is not run.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // Workers finish the queued tasks and exit.
+    void shutdown();
+
+private:
+    typedef struct
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    } WorkQueue;
+
+    explicit AmlThreadPool(size_t threads);
+
+    void push(size_t queue, const Task& task);
+    bool take(size_t self, Task& task);
+    void work(size_t self);
+
+    std::vector<std::unique_ptr<WorkQueue> > m_queues;
+    std::atomic<size_t> m_nextQueue;    // queue of the next task submitted from outside of the pool
+    std::atomic<size_t> m_pending;      // tasks in the queues
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    bool m_stop;                        // guarded by 'm_mtx'
+};
+
+// Pool of conversions, created on first use with the size of SetConvertThreadCount().
+std::shared_ptr<AmlThreadPool> AcquireThreadPool();
+
+// 0 is the number of cores. The pool in use is shut down and replaced.
+void SetThreadPoolSize(size_t threads);
+size_t GetThreadPoolSize();
+
+#endif // C_AML_THREAD_POOL_H_
@@ -18,15 +18,59 @@
 #ifndef C_AML_UTILS_H_
 #define C_AML_UTILS_H_
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 
+#include "AMLInterface.h"
 #include "AMLException.h"
 #include "camlerrorcodes.h"
 
-char* ConvertStringToCharStr(std::string str);
+char* ConvertStringToCharStr(const std::string& str);
 char** ConvertVectorToCharStrArr(std::vector<std::string>& list);
 
 CAMLErrorCode ExceptionCodeToErrorCode(AML::ResultCode result);
 
+bool ParseEpoch(const std::string& str, int64_t* epoch);
+std::string FormatEpoch(int64_t epoch);
+
+size_t EstimateMemoryUsage(const AML::AMLData& amlData);
+size_t EstimateMemoryUsage(const AML::AMLObject& amlObj);
+
+#define VARINT_MAX_SIZE     10
+
+// Encodes 'value' to 'out', which should have room for VARINT_MAX_SIZE bytes. Returns the number of bytes encoded.
+size_t EncodeVarint(uint8_t* out, uint64_t value);
+void AppendVarint(std::string& out, uint64_t value);
+bool ReadVarint(const uint8_t** pos, const uint8_t* end, uint64_t* value);
+// Reads a varint length and the bytes following it. Returns false if the section exceeds 'end'.
+bool ReadSection(const uint8_t** pos, const uint8_t* end, const uint8_t** section, size_t* size);
+
+uint64_t HashFnv1a(const char* data, size_t size);
+uint32_t Crc32c(const uint8_t* data, size_t size);
+
+// Writes all of 'buffer' to 'fd', retrying on partial writes and EINTR.
+bool WriteAll(int fd, const char* buffer, size_t size);
+
+/**
+ * Scratch buffer of the calling thread which input data is copied to, so that its capacity is reused
+ * instead of allocated again. It saves the allocation, not the copy.
+ * If the buffer is already in use on the thread, a string of its own is used.
+ */
+class ScratchBuffer
+{
+public:
+    ScratchBuffer(const char* data, size_t size);
+    ~ScratchBuffer();
+
+    const std::string& str() const;
+
+private:
+    ScratchBuffer(const ScratchBuffer&);
+    ScratchBuffer& operator=(const ScratchBuffer&);
+
+    std::string m_own;
+    std::string* m_str;
+};
+
 #endif // C_AML_UTILS_H_
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef C_AML_XML_SCANNER_H_
+#define C_AML_XML_SCANNER_H_
+
+#include <stddef.h>
+#include <string>
+
+typedef enum
+{
+    XML_TOKEN_START_TAG = 0,    // <name ...>
+    XML_TOKEN_END_TAG,          // </name>
+    XML_TOKEN_EMPTY_TAG,        // <name .../>
+    XML_TOKEN_TEXT,
+    XML_TOKEN_COMMENT,          // <!-- ... -->
+    XML_TOKEN_CDATA,            // <![CDATA[ ... ]]>
+    XML_TOKEN_DECLARATION       // <? ... ?> or <! ... >
+} XmlTokenType;
+
+/**
+ * A token of XML document, pointing into the scanned buffer.
+ * 'name' is set for tags only.
+ */
+typedef struct
+{
+    XmlTokenType type;
+    const char* begin;
+    const char* end;
+    const char* name;
+    size_t nameSize;
+} XmlToken;
+
+/**
+ * Splits XML document into tokens without copying it.
+ * Well-formedness of the document (e.g. matching of tags) is not checked.
+ * With 'partial', data is a part of document, and a token which may continue after data is left unscanned.
+ */
+class XmlScanner
+{
+public:
+    XmlScanner(const char* data, size_t size, bool partial = false);
+
+    // Returns false at the end of data. Throws AMLException(INVALID_XML_STR) on a broken token.
+    bool next(XmlToken& token);
+
+    // Size of data which is split into tokens so far.
+    size_t scanned() const;
+
+private:
+    const char* m_begin;
+    const char* m_pos;
+    const char* m_end;
+    bool m_partial;
+};
+
+// Finds a raw attribute value of a start tag or an empty tag, pointing into the token.
+// Returns false if there is no such attribute.
+bool FindXmlAttribute(const XmlToken& token, const char* name, const char** value, size_t* size);
+
+// Gets a raw attribute value of a start tag or an empty tag. Returns false if there is no such attribute.
+bool GetXmlAttribute(const XmlToken& token, const char* name, std::string& value);
+
+// Appends text with character and entity references replaced. Throws AMLException(INVALID_XML_STR) on a bad reference.
+void AppendXmlText(const char* begin, const char* end, std::string& out);
+
+#endif // C_AML_XML_SCANNER_H_
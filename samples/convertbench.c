@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+/*
+ * Measures Representation_ConvertBatch() with 1 thread up to the number of cores,
+ * and prints the throughput of each conversion for each number of threads, with its ratio to 1 thread.
+ *
+ * usage : convertbench [objects] [rounds]
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "camlinterface.h"
+#include "camlrepresentation.h"
+#include "camlerrorcodes.h"
+
+#define DEFAULT_OBJECTS     10000
+#define DEFAULT_ROUNDS      5
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static amlObjectHandle_t createObject(size_t index)
+{
+    amlDataHandle_t model;
+    CreateAMLData(&model);
+    AMLData_SetValueStr(model, "a", "Model_107.113.97.248");
+    AMLData_SetValueStr(model, "b", "SR-P7-970");
+
+    amlDataHandle_t axis;
+    CreateAMLData(&axis);
+    AMLData_SetValueStr(axis, "x", "20");
+    AMLData_SetValueStr(axis, "y", "110");
+    AMLData_SetValueStr(axis, "z", "80");
+
+    amlDataHandle_t info;
+    CreateAMLData(&info);
+    char id[32];
+    snprintf(id, sizeof(id), "%08zx", index);
+    AMLData_SetValueStr(info, "id", id);
+    AMLData_SetValueAMLData(info, "axis", axis);
+
+    amlDataHandle_t sample;
+    CreateAMLData(&sample);
+    AMLData_SetValueAMLData(sample, "info", info);
+    const char* appendix[3] = {"935", "52303", "1442"};
+    AMLData_SetValueStrArr(sample, "appendix", appendix, 3);
+
+    amlObjectHandle_t object;
+    CreateAMLObjectWithEpoch("SAMPLE001", 1500000000000 + index, &object);
+    AMLObject_AddData(object, "Model", model);
+    AMLObject_AddData(object, "Sample", sample);
+
+    DestroyAMLData(model);
+    DestroyAMLData(axis);
+    DestroyAMLData(info);
+    DestroyAMLData(sample);
+
+    return object;
+}
+
+// Returns the best time of 'rounds', freeing the outputs after each round.
+static double measure(representation_t rep, CAMLConvertType type, CAMLConvertItem* items, size_t count, int rounds)
+{
+    double best = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+        CAMLErrorCode result = Representation_ConvertBatch(rep, type, items, count);
+        double elapsed = now() - start;
+        if (CAML_OK != result)
+        {
+            printf("Representation_ConvertBatch failed : %d\n", result);
+            exit(1);
+        }
+        if (0 == round || elapsed < best)
+        {
+            best = elapsed;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (CAML_CONVERT_DATA_TO_AML == type)
+            {
+                free(items[i].aml);
+                items[i].aml = NULL;
+            }
+            else if (CAML_CONVERT_DATA_TO_BYTE == type)
+            {
+                free(items[i].byte);
+                items[i].byte = NULL;
+            }
+        }
+    }
+
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_OBJECTS;
+    int rounds = (argc > 2) ? atoi(argv[2]) : DEFAULT_ROUNDS;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (0 == count || rounds <= 0 || cores <= 0)
+    {
+        printf("usage : %s [objects] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    representation_t rep;
+    if (CAML_OK != CreateRepresentation("sample_data_model.aml", &rep))
+    {
+        printf("Failed to load sample_data_model.aml\n");
+        return 1;
+    }
+
+    amlObjectHandle_t* objects = (amlObjectHandle_t*)malloc(count * sizeof(amlObjectHandle_t));
+    CAMLConvertItem* items = (CAMLConvertItem*)calloc(count, sizeof(CAMLConvertItem));
+    for (size_t i = 0; i < count; i++)
+    {
+        objects[i] = createObject(i);
+        items[i].amlObj = objects[i];
+    }
+
+    printf("%zu objects, best of %d rounds\n", count, rounds);
+    printf("threads   DataToAml/s  vs 1   DataToByte/s  vs 1\n");
+
+    double baseAml = 0;
+    double baseByte = 0;
+    for (long threads = 1; threads <= cores; threads++)
+    {
+        SetConvertThreadCount((size_t)threads);
+
+        // The pool starts on the first conversion, which is left out of the measurement.
+        Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_AML, items, 1);
+        free(items[0].aml);
+        items[0].aml = NULL;
+
+        double aml = measure(rep, CAML_CONVERT_DATA_TO_AML, items, count, rounds);
+        double byte = measure(rep, CAML_CONVERT_DATA_TO_BYTE, items, count, rounds);
+        if (1 == threads)
+        {
+            baseAml = aml;
+            baseByte = byte;
+        }
+
+        printf("%7ld  %12.0f  %4.2f  %13.0f  %4.2f\n",
+               threads, count / aml, baseAml / aml, count / byte, baseByte / byte);
+    }
+
+    DestroyAMLObjects(objects, count);
+    free(objects);
+    free(items);
+    DestroyRepresentation(rep);
+
+    return 0;
+}
@@ -19,15 +19,14 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
-#include <time.h>
-#include <sys/timeb.h>
+#include <sys/time.h>
 
 #include "camlinterface.h"
 #include "camlrepresentation.h"
 #include "camlerrorcodes.h"
 
 // helper methods
-char* getCurrentTime();
+int64_t getCurrentEpoch();
 void freeCharArr(char** str, size_t size);
 void printAMLData(amlDataHandle_t amlData, int depth);
 void printAMLObject(amlObjectHandle_t amlObj);
@@ -106,9 +105,7 @@ int main()
 
     // set datas to object
     amlObjectHandle_t object;
-    char* currTime = getCurrentTime();
-    CreateAMLObject("SAMPLE001", currTime, &object);
-    free(currTime);
+    CreateAMLObjectWithEpoch("SAMPLE001", getCurrentEpoch(), &object);
     AMLObject_AddData(object, "Model", model);
     AMLObject_AddData(object, "Sample", sample);
 
@@ -165,22 +162,12 @@ void representationConvertApiTest(representation_t rep, amlObjectHandle_t object
     DestroyAMLObject(objectFromByte);
 }
 
-char* getCurrentTime()
+int64_t getCurrentEpoch()
 {
-    char* timeStr = (char*)malloc(sizeof(char) * 10);
-    if (NULL == timeStr) return NULL;
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
 
-    struct timeb tp;
-    ftime(&tp);
-    strftime(timeStr, 7, "%H%M%S", localtime(&tp.time));
-
-    char milliSec[4];
-    snprintf(milliSec, 4, "%d", tp.millitm);
-
-    strncpy(timeStr + 6, milliSec, 3);
-    timeStr[9] = '\0';
-
-    return timeStr;
+    return (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
 }
 
 void freeCharArr(char** str, size_t size)
@@ -0,0 +1,435 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "AMLException.h"
+
+#include "camlamlparser.h"
+
+using namespace std;
+using namespace AML;
+
+// InternalElement of AMLObject, which has AMLData as child InternalElements.
+#define AML_OBJECT_DEPTH    1
+#define AML_DATA_DEPTH      2
+
+static bool IsTag(const char* name, size_t nameSize, const char* tag)
+{
+    return strlen(tag) == nameSize && 0 == memcmp(name, tag, nameSize);
+}
+
+static void AppendName(const XmlToken& token, string& out)
+{
+    const char* name = NULL;
+    size_t size = 0;
+    if (!FindXmlAttribute(token, "Name", &name, &size))
+    {
+        throw AMLException(INVALID_AML_SCHEMA);
+    }
+    AppendXmlText(name, name + size, out);
+}
+
+AmlEventParser::AmlEventParser(const Handler& handler)
+    : m_handler(handler), m_seenInstanceHierarchy(false), m_inInstanceHierarchy(false),
+      m_elementDepth(0), m_dataKeyOffset(0), m_inValue(false)
+{
+}
+
+bool AmlEventParser::inData() const
+{
+    return AML_DATA_DEPTH == m_elementDepth;
+}
+
+bool AmlEventParser::emit(CAMLParseEventType type, size_t keyOffset, size_t keyEnd, const string* value)
+{
+    CAMLParseEvent event;
+    event.type = type;
+    event.key = m_keys.data() + keyOffset;
+    event.keySize = keyEnd - keyOffset;
+    event.value = value ? value->data() : NULL;
+    event.valueSize = value ? value->size() : 0;
+
+    return m_handler(event);
+}
+
+bool AmlEventParser::startAttribute(const XmlToken& token)
+{
+    if (!m_attributes.empty() && inData())
+    {
+        AttributeFrame& parent = m_attributes.back();
+        if (ATTRIBUTE_UNKNOWN == parent.kind)
+        {
+            parent.kind = ATTRIBUTE_NESTED;
+            if (!emit(AMLPARSE_NESTED_BEGIN, parent.keyOffset, m_keys.size(), NULL))
+            {
+                return false;
+            }
+        }
+    }
+
+    AttributeFrame frame;
+    frame.keyOffset = m_keys.size();
+    frame.kind = ATTRIBUTE_UNKNOWN;
+    AppendName(token, m_keys);
+    m_attributes.push_back(frame);
+
+    return true;
+}
+
+bool AmlEventParser::endAttribute()
+{
+    if (m_attributes.empty())
+    {
+        throw AMLException(INVALID_XML_STR);
+    }
+
+    AttributeFrame frame = m_attributes.back();
+    bool proceed = true;
+    if (ATTRIBUTE_UNKNOWN == frame.kind)
+    {
+        // Attribute without value has an empty string.
+        m_value.clear();
+        proceed = emit(inData() ? AMLPARSE_VALUE : AMLPARSE_HEADER, frame.keyOffset, m_keys.size(), &m_value);
+    }
+    else if (inData() && ATTRIBUTE_ARRAY == frame.kind)
+    {
+        proceed = emit(AMLPARSE_ARRAY_END, frame.keyOffset, m_keys.size(), NULL);
+    }
+    else if (inData() && ATTRIBUTE_NESTED == frame.kind)
+    {
+        proceed = emit(AMLPARSE_NESTED_END, frame.keyOffset, m_keys.size(), NULL);
+    }
+
+    m_attributes.pop_back();
+    m_keys.resize(frame.keyOffset);
+
+    return proceed;
+}
+
+bool AmlEventParser::startElement(const XmlToken& token)
+{
+    if (IsTag(token.name, token.nameSize, "InstanceHierarchy"))
+    {
+        m_seenInstanceHierarchy = true;
+        m_inInstanceHierarchy = true;
+        return true;
+    }
+
+    if (!m_inInstanceHierarchy)
+    {
+        return true;
+    }
+
+    if (IsTag(token.name, token.nameSize, "InternalElement"))
+    {
+        if (!m_attributes.empty() || AML_DATA_DEPTH <= m_elementDepth)
+        {
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+
+        m_elementDepth++;
+        if (inData())
+        {
+            m_dataKeyOffset = m_keys.size();
+            AppendName(token, m_keys);
+            return emit(AMLPARSE_DATA_BEGIN, m_dataKeyOffset, m_keys.size(), NULL);
+        }
+    }
+    else if (0 == m_elementDepth)
+    {
+        return true;
+    }
+    else if (IsTag(token.name, token.nameSize, "Attribute"))
+    {
+        return startAttribute(token);
+    }
+    else if (IsTag(token.name, token.nameSize, "Value") && !m_attributes.empty())
+    {
+        m_attributes.back().kind = ATTRIBUTE_VALUE;
+        m_inValue = true;
+        m_value.clear();
+    }
+    else if (IsTag(token.name, token.nameSize, "RefSemantic") && !m_attributes.empty())
+    {
+        const char* path = NULL;
+        size_t size = 0;
+        if (FindXmlAttribute(token, "CorrespondingAttributePath", &path, &size) &&
+            IsTag(path, size, "OrderedListType") && ATTRIBUTE_UNKNOWN == m_attributes.back().kind)
+        {
+            AttributeFrame& frame = m_attributes.back();
+            frame.kind = ATTRIBUTE_ARRAY;
+            if (inData())
+            {
+                return emit(AMLPARSE_ARRAY_BEGIN, frame.keyOffset, m_keys.size(), NULL);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool AmlEventParser::endElement(const char* name, size_t nameSize)
+{
+    if (IsTag(name, nameSize, "InstanceHierarchy"))
+    {
+        if (0 != m_elementDepth)
+        {
+            throw AMLException(INVALID_XML_STR);
+        }
+        m_inInstanceHierarchy = false;
+        return true;
+    }
+
+    if (!m_inInstanceHierarchy)
+    {
+        return true;
+    }
+
+    if (IsTag(name, nameSize, "InternalElement"))
+    {
+        if (0 == m_elementDepth || !m_attributes.empty())
+        {
+            throw AMLException(INVALID_XML_STR);
+        }
+
+        bool proceed = true;
+        if (inData())
+        {
+            proceed = emit(AMLPARSE_DATA_END, m_dataKeyOffset, m_keys.size(), NULL);
+            m_keys.resize(m_dataKeyOffset);
+        }
+        m_elementDepth--;
+        return proceed;
+    }
+    else if (0 == m_elementDepth)
+    {
+        return true;
+    }
+    else if (IsTag(name, nameSize, "Attribute"))
+    {
+        return endAttribute();
+    }
+    else if (IsTag(name, nameSize, "Value") && m_inValue)
+    {
+        m_inValue = false;
+        return emit(inData() ? AMLPARSE_VALUE : AMLPARSE_HEADER, m_attributes.back().keyOffset, m_keys.size(), &m_value);
+    }
+
+    return true;
+}
+
+bool AmlEventParser::parse(const XmlToken& token)
+{
+    switch (token.type)
+    {
+        case XML_TOKEN_START_TAG :
+            return startElement(token);
+        case XML_TOKEN_EMPTY_TAG :
+            return startElement(token) && endElement(token.name, token.nameSize);
+        case XML_TOKEN_END_TAG :
+            return endElement(token.name, token.nameSize);
+        case XML_TOKEN_TEXT :
+            if (m_inValue)
+            {
+                AppendXmlText(token.begin, token.end, m_value);
+            }
+            return true;
+        case XML_TOKEN_CDATA :
+            if (m_inValue)
+            {
+                // <![CDATA[ ... ]]>
+                m_value.append(token.begin + 9, token.end - token.begin - 12);
+            }
+            return true;
+        default :
+            return true;
+    }
+}
+
+void AmlEventParser::finish() const
+{
+    if (!m_seenInstanceHierarchy)
+    {
+        throw AMLException(INVALID_AML_SCHEMA);
+    }
+    if (m_inInstanceHierarchy)
+    {
+        throw AMLException(INVALID_XML_STR);
+    }
+}
+
+bool ParseAmlEvents(const char* data, size_t size, const AmlEventParser::Handler& handler)
+{
+    AmlEventParser parser(handler);
+    XmlScanner scanner(data, size);
+    XmlToken token;
+    while (scanner.next(token))
+    {
+        if (!parser.parse(token))
+        {
+            return false;
+        }
+    }
+
+    parser.finish();
+    return true;
+}
+
+AmlObjectBuilder::AmlObjectBuilder()
+    : m_inArray(false)
+{
+}
+
+bool AmlObjectBuilder::onEvent(const CAMLParseEvent& event)
+{
+    string key(event.key, event.keySize);
+
+    if (AMLPARSE_HEADER != event.type && AMLPARSE_DATA_BEGIN != event.type &&
+        m_nested.size() < (AMLPARSE_NESTED_END == event.type ? 2u : 1u))
+    {
+        throw AMLException(INVALID_XML_STR);
+    }
+
+    switch (event.type)
+    {
+        case AMLPARSE_HEADER :
+            if ("device" == key)
+            {
+                m_deviceId.assign(event.value, event.valueSize);
+            }
+            else if ("timestamp" == key)
+            {
+                m_timeStamp.assign(event.value, event.valueSize);
+            }
+            else if ("id" == key)
+            {
+                m_id.assign(event.value, event.valueSize);
+            }
+            break;
+        case AMLPARSE_DATA_BEGIN :
+        case AMLPARSE_NESTED_BEGIN :
+            m_nested.push_back(make_pair(key, AMLData()));
+            break;
+        case AMLPARSE_DATA_END :
+            m_datas.push_back(m_nested.back());
+            m_nested.pop_back();
+            break;
+        case AMLPARSE_NESTED_END :
+        {
+            pair<string, AMLData> nested = m_nested.back();
+            m_nested.pop_back();
+            m_nested.back().second.setValue(nested.first, nested.second);
+            break;
+        }
+        case AMLPARSE_ARRAY_BEGIN :
+            m_inArray = true;
+            m_arrayKey = key;
+            m_array.clear();
+            break;
+        case AMLPARSE_ARRAY_END :
+            m_inArray = false;
+            m_nested.back().second.setValue(m_arrayKey, m_array);
+            break;
+        case AMLPARSE_VALUE :
+            if (m_inArray)
+            {
+                m_array.push_back(string(event.value, event.valueSize));
+            }
+            else
+            {
+                m_nested.back().second.setValue(key, string(event.value, event.valueSize));
+            }
+            break;
+    }
+
+    return true;
+}
+
+AMLObject* AmlObjectBuilder::build() const
+{
+    if (m_deviceId.empty() || m_timeStamp.empty())
+    {
+        throw AMLException(INVALID_AML_SCHEMA);
+    }
+
+    AMLObject* amlObj = m_id.empty() ? new AMLObject(m_deviceId, m_timeStamp)
+                                     : new AMLObject(m_deviceId, m_timeStamp, m_id);
+    try
+    {
+        for (const pair<string, AMLData>& data : m_datas)
+        {
+            amlObj->addData(data.first, data.second);
+        }
+    }
+    catch (...)
+    {
+        delete amlObj;
+        throw;
+    }
+
+    return amlObj;
+}
+
+AmlPushParser::AmlPushParser()
+    : m_parser([this](const CAMLParseEvent& event)
+      {
+          return m_builder.onEvent(event);
+      })
+{
+}
+
+void AmlPushParser::parse(const char* data, size_t size, bool partial)
+{
+    XmlScanner scanner(data, size, partial);
+    XmlToken token;
+    while (scanner.next(token))
+    {
+        m_parser.parse(token);
+    }
+
+    // Only the unfinished token is kept, so that a part is not copied as a whole.
+    string rest(data + scanner.scanned(), size - scanner.scanned());
+    m_pending.swap(rest);
+}
+
+void AmlPushParser::feed(const char* data, size_t size)
+{
+    if (m_pending.empty())
+    {
+        parse(data, size, true);
+    }
+    else
+    {
+        string joined;
+        joined.reserve(m_pending.size() + size);
+        joined.append(m_pending).append(data, size);
+        parse(joined.data(), joined.size(), true);
+    }
+}
+
+AMLObject* AmlPushParser::finish()
+{
+    string rest;
+    rest.swap(m_pending);
+    parse(rest.data(), rest.size(), false);
+
+    m_parser.finish();
+    return m_builder.build();
+}
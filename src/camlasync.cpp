@@ -0,0 +1,286 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <memory>
+#include <thread>
+#include <system_error>
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+#include "camlrepresentation.h"
+#include "camlinterface.h"
+#include "camlerrorcodes.h"
+#include "camlhandlemanager.h"
+#include "camlutils.h"
+#include "camlthreadpool.h"
+
+using namespace std;
+using namespace AML;
+
+/**
+ * Completions of conversions, with eventfd which is readable while there is any.
+ */
+typedef struct
+{
+    mutex mtx;
+    deque<CAMLCompletion> completions;
+    int fd;
+} AmlCompletionQueue;
+
+// Queues 'task' on the pool of conversions. Throws std::system_error if a thread fails to start.
+static void SubmitConversion(const AmlThreadPool::Task& task)
+{
+    // The pool refuses tasks once it is replaced by SetConvertThreadCount(), then the new one takes them.
+    while (!AcquireThreadPool()->submit(task))
+    {
+        this_thread::yield();
+    }
+}
+
+static void ConvertDataToByte(AmlModel& model, CAMLCompletion& completion)
+{
+    AMLObject* amlObj = FindAmlObj(completion.amlObj);
+    if (!amlObj)
+    {
+        completion.result = CAML_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        string byteString = AcquireRepresentation(model, *amlObj)->DataToByte(*amlObj);
+        char* byte = ConvertStringToCharStr(byteString);
+        if (NULL == byte)
+        {
+            completion.result = CAML_NO_MEMORY;
+            return;
+        }
+        completion.byte = (uint8_t*)byte;
+        completion.size = byteString.size();
+    }
+    catch (const AMLException& e)
+    {
+        completion.result = ExceptionCodeToErrorCode(e.code());
+    }
+    catch (const bad_alloc&)
+    {
+        completion.result = CAML_NO_MEMORY;
+    }
+}
+
+static void ConvertByteToData(AmlModel& model, const string& byte, CAMLCompletion& completion)
+{
+    AMLObject* amlObj = NULL;
+    try
+    {
+        // Binary data does not tell its SystemUnitClasses before it is decoded.
+        amlObj = AcquireFullRepresentation(model)->ByteToData(byte);
+    }
+    catch (const AMLException& e)
+    {
+        completion.result = ExceptionCodeToErrorCode(e.code());
+        return;
+    }
+    catch (const bad_alloc&)
+    {
+        completion.result = CAML_NO_MEMORY;
+        return;
+    }
+
+    completion.amlObj = AddAmlObjHandle(amlObj, true);
+    if (!completion.amlObj)
+    {
+        delete amlObj;
+        completion.result = CAML_NO_MEMORY;
+    }
+}
+
+CAMLErrorCode Representation_DataToByteAsync(const representation_t repHandle, const amlObjectHandle_t amlObjHandle,
+                                             CAMLCompletionCallback callback, void* userData)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(callback);
+
+    // The model is kept by the task, even if Representation is destroyed before the conversion.
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model || !FindAmlObj(amlObjHandle))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    try
+    {
+        SubmitConversion([model, amlObjHandle, callback, userData]()
+        {
+            CAMLCompletion completion = { CAML_OK, amlObjHandle, NULL, 0, userData };
+            ConvertDataToByte(*model, completion);
+            callback(&completion);
+        });
+    }
+    catch (const system_error&)
+    {
+        return CAML_NO_MEMORY;
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_ByteToDataAsync(const representation_t repHandle, const uint8_t* byte, const size_t size,
+                                             CAMLCompletionCallback callback, void* userData)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(byte);
+    VERIFY_PARAM_NON_NULL(size);
+    VERIFY_PARAM_NON_NULL(callback);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    try
+    {
+        shared_ptr<string> byteString(new string((const char*)byte, size));
+        SubmitConversion([model, byteString, callback, userData]()
+        {
+            CAMLCompletion completion = { CAML_OK, NULL, NULL, 0, userData };
+            ConvertByteToData(*model, *byteString, completion);
+            callback(&completion);
+        });
+    }
+    catch (const system_error&)
+    {
+        return CAML_NO_MEMORY;
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode CreateAMLCompletionQueue(amlCompletionQueue_t* queue)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+
+    AmlCompletionQueue* completionQueue = new(std::nothrow) AmlCompletionQueue;
+    if (NULL == completionQueue)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    completionQueue->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (completionQueue->fd < 0)
+    {
+        delete completionQueue;
+        return CAML_NO_MEMORY;
+    }
+
+    *queue = completionQueue;
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLCompletionQueue(amlCompletionQueue_t queue)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+
+    AmlCompletionQueue* completionQueue = (AmlCompletionQueue*)queue;
+    close(completionQueue->fd);
+    delete completionQueue;
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLCompletionQueue_GetFd(amlCompletionQueue_t queue, int* fd)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    VERIFY_PARAM_NON_NULL(fd);
+
+    *fd = ((AmlCompletionQueue*)queue)->fd;
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLCompletionQueue_Post(amlCompletionQueue_t queue, const CAMLCompletion* completion)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    VERIFY_PARAM_NON_NULL(completion);
+
+    AmlCompletionQueue* completionQueue = (AmlCompletionQueue*)queue;
+
+    // The counter is changed with the queue, so that the descriptor is readable exactly while the queue is not empty.
+    lock_guard<mutex> lock(completionQueue->mtx);
+    try
+    {
+        completionQueue->completions.push_back(*completion);
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    if (1 == completionQueue->completions.size())
+    {
+        uint64_t one = 1;
+        ssize_t written = write(completionQueue->fd, &one, sizeof(one));
+        (void)written;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLCompletionQueue_Pop(amlCompletionQueue_t queue, CAMLCompletion* completion)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    VERIFY_PARAM_NON_NULL(completion);
+
+    AmlCompletionQueue* completionQueue = (AmlCompletionQueue*)queue;
+
+    lock_guard<mutex> lock(completionQueue->mtx);
+    if (completionQueue->completions.empty())
+    {
+        return CAML_QUEUE_EMPTY;
+    }
+
+    *completion = completionQueue->completions.front();
+    completionQueue->completions.pop_front();
+
+    if (completionQueue->completions.empty())
+    {
+        uint64_t count = 0;
+        ssize_t drained = read(completionQueue->fd, &count, sizeof(count));
+        (void)drained;
+    }
+
+    return CAML_OK;
+}
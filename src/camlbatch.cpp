@@ -0,0 +1,821 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <string>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <system_error>
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+#include "camlrepresentation.h"
+#include "camlinterface.h"
+#include "camlerrorcodes.h"
+#include "camlhandlemanager.h"
+#include "camlutils.h"
+#include "camlxmlscanner.h"
+#include "camlthreadpool.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+ * Byte batch:
+ *   magic 'C','A','M','B' | version | repId (varint length + bytes) | count (varint) |
+ *   AMLObjects (varint length + bytes of Representation::DataToByte(), 'count' times) | CRC-32C
+ * CRC-32C is stored in little endian and covers all preceding bytes.
+ */
+#define BATCH_MAGIC         "CAMB"
+#define BATCH_MAGIC_SIZE    4
+#define BATCH_VERSION       1
+#define BATCH_CRC_SIZE      4
+
+#define CAEX_FILE_END_TAG   "</CAEXFile>"
+
+#define FRAME_MIN_CAPACITY  256
+
+static void StoreBatchCrc(uint8_t* out, uint32_t crc)
+{
+    for (int i = 0; i < BATCH_CRC_SIZE; i++)
+    {
+        out[i] = (uint8_t)((crc >> (8 * i)) & 0xFF);
+    }
+}
+
+static uint32_t LoadBatchCrc(const uint8_t* in)
+{
+    uint32_t crc = 0;
+    for (int i = 0; i < BATCH_CRC_SIZE; i++)
+    {
+        crc |= (uint32_t)in[i] << (8 * i);
+    }
+    return crc;
+}
+
+/**
+ * Sections of a byte batch, which point into the batch.
+ */
+typedef struct AmlByteBatchLayout
+{
+    const uint8_t* repId;
+    size_t repIdSize;
+    uint64_t count;
+    const uint8_t* items;       // 'count' sections of AMLObjects
+    const uint8_t* end;         // CRC-32C
+} AmlByteBatchLayout;
+
+// Checks magic, version, CRC-32C and all sections of a byte batch. Returns false on a broken batch.
+static bool ReadByteBatchLayout(const uint8_t* byte, size_t size, AmlByteBatchLayout* layout)
+{
+    if (size < BATCH_MAGIC_SIZE + 1 + BATCH_CRC_SIZE ||
+        0 != memcmp(byte, BATCH_MAGIC, BATCH_MAGIC_SIZE) ||
+        BATCH_VERSION != byte[BATCH_MAGIC_SIZE])
+    {
+        return false;
+    }
+
+    const uint8_t* end = byte + size - BATCH_CRC_SIZE;
+    if (LoadBatchCrc(end) != Crc32c(byte, end - byte))
+    {
+        return false;
+    }
+
+    const uint8_t* pos = byte + BATCH_MAGIC_SIZE + 1;
+    if (!ReadSection(&pos, end, &layout->repId, &layout->repIdSize) || !ReadVarint(&pos, end, &layout->count))
+    {
+        return false;
+    }
+
+    layout->items = pos;
+    for (uint64_t i = 0; i < layout->count; i++)
+    {
+        const uint8_t* section = NULL;
+        size_t sectionSize = 0;
+        if (!ReadSection(&pos, end, &section, &sectionSize))
+        {
+            return false;
+        }
+    }
+    layout->end = end;
+
+    return pos == end;
+}
+
+/**
+ * Byte batch built in a buffer of malloc(), which is handed to the caller as it is.
+ */
+class AmlByteBatchFrame
+{
+public:
+    AmlByteBatchFrame() : m_data(NULL), m_size(0), m_capacity(0) {}
+    ~AmlByteBatchFrame()
+    {
+        free(m_data);
+    }
+
+    // Returns false if memory is not enough.
+    bool append(const void* data, size_t size)
+    {
+        if (!reserve(size))
+        {
+            return false;
+        }
+        memcpy(m_data + m_size, data, size);
+        m_size += size;
+        return true;
+    }
+
+    bool appendVarint(uint64_t value)
+    {
+        if (!reserve(VARINT_MAX_SIZE))
+        {
+            return false;
+        }
+        m_size += EncodeVarint(m_data + m_size, value);
+        return true;
+    }
+
+    // Appends CRC-32C of the frame so far.
+    bool appendCrc()
+    {
+        if (!reserve(BATCH_CRC_SIZE))
+        {
+            return false;
+        }
+        StoreBatchCrc(m_data + m_size, Crc32c(m_data, m_size));
+        m_size += BATCH_CRC_SIZE;
+        return true;
+    }
+
+    // The caller takes the buffer, which should be freed with free().
+    uint8_t* release(size_t* size)
+    {
+        uint8_t* data = m_data;
+        *size = m_size;
+        m_data = NULL;
+        m_size = m_capacity = 0;
+        return data;
+    }
+
+private:
+    AmlByteBatchFrame(const AmlByteBatchFrame&);
+    AmlByteBatchFrame& operator=(const AmlByteBatchFrame&);
+
+    bool reserve(size_t more)
+    {
+        if (m_capacity - m_size >= more)
+        {
+            return true;
+        }
+        if (more > SIZE_MAX / 2 - m_size)
+        {
+            return false;
+        }
+
+        size_t capacity = (m_capacity < FRAME_MIN_CAPACITY) ? FRAME_MIN_CAPACITY : m_capacity;
+        while (capacity - m_size < more)
+        {
+            capacity *= 2;
+        }
+
+        uint8_t* data = (uint8_t*)realloc(m_data, capacity);
+        if (NULL == data)
+        {
+            return false;
+        }
+        m_data = data;
+        m_capacity = capacity;
+        return true;
+    }
+
+    uint8_t* m_data;
+    size_t m_size;
+    size_t m_capacity;
+};
+
+/**
+ * Decodes AMLObjects of a batch one at a time.
+ */
+class AmlBatchIterator
+{
+public:
+    virtual ~AmlBatchIterator() {}
+
+    // Throws AMLException on failure.
+    virtual size_t count() = 0;
+
+    // Returns NULL after the last AMLObject. Throws AMLException on failure.
+    virtual AMLObject* next() = 0;
+};
+
+class AmlByteBatchIterator : public AmlBatchIterator
+{
+public:
+    // Checks the whole frame, but decodes no AMLObject. Throws AMLException(INVALID_BYTE_STR) on a broken frame.
+    AmlByteBatchIterator(const shared_ptr<AmlModel>& model, const uint8_t* byte, size_t size)
+        : m_model(model), m_count(0), m_index(0)
+    {
+        AmlByteBatchLayout layout;
+        if (!ReadByteBatchLayout(byte, size, &layout))
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+
+        // Binary data does not tell its SystemUnitClasses before it is decoded.
+        m_rep = AcquireFullRepresentation(*m_model);
+        if (m_rep->getRepresentationId() != string((const char*)layout.repId, layout.repIdSize))
+        {
+            throw AMLException(NOT_MATCH_TO_AML_MODEL);
+        }
+        m_pos = layout.items;
+        m_end = layout.end;
+        m_count = layout.count;
+    }
+
+    size_t count()
+    {
+        return m_count;
+    }
+
+    AMLObject* next()
+    {
+        if (m_index == m_count)
+        {
+            return NULL;
+        }
+
+        const uint8_t* section = NULL;
+        size_t size = 0;
+        ReadSection(&m_pos, m_end, &section, &size);
+        m_index++;
+
+        ScratchBuffer byteString((const char*)section, size);
+        return m_rep->ByteToData(byteString.str());
+    }
+
+private:
+    shared_ptr<AmlModel> m_model;
+    shared_ptr<Representation> m_rep;
+    const uint8_t* m_pos;
+    const uint8_t* m_end;
+    size_t m_count;
+    size_t m_index;
+};
+
+static bool IsTag(const XmlToken& token, const char* tag)
+{
+    return strlen(tag) == token.nameSize && 0 == memcmp(token.name, tag, token.nameSize);
+}
+
+/**
+ * Reads InstanceHierarchies of AML document one at a time, as far as they are needed.
+ * Each of them is converted as a document of the header of the batch and the InstanceHierarchy alone.
+ */
+class AmlXmlBatchIterator : public AmlBatchIterator
+{
+public:
+    // Throws AMLException if there is no CAEXFile.
+    AmlXmlBatchIterator(const shared_ptr<AmlModel>& model, const char* aml, size_t size)
+        : m_model(model), m_aml(aml), m_scanner(aml, size), m_headerSize(0), m_index(0), m_ended(false)
+    {
+        XmlToken token;
+        while (0 == m_headerSize)
+        {
+            if (!m_scanner.next(token))
+            {
+                throw AMLException(INVALID_AML_SCHEMA);
+            }
+            if (XML_TOKEN_START_TAG == token.type && IsTag(token, "CAEXFile"))
+            {
+                m_headerSize = token.end - aml;
+            }
+        }
+    }
+
+    size_t count()
+    {
+        pair<size_t, size_t> range;
+        while (scan(range))
+        {
+            m_ranges.push_back(range);
+        }
+        return m_ranges.size();
+    }
+
+    AMLObject* next()
+    {
+        pair<size_t, size_t> range;
+        if (m_index < m_ranges.size())
+        {
+            range = m_ranges[m_index];
+        }
+        else if (scan(range))
+        {
+            m_ranges.push_back(range);
+        }
+        else
+        {
+            return NULL;
+        }
+        m_index++;
+
+        m_doc.assign(m_aml, m_headerSize);
+        m_doc.append(m_aml + range.first, range.second - range.first);
+        m_doc.append(CAEX_FILE_END_TAG);
+
+        return ConvertAmlToData(*m_model, m_doc);
+    }
+
+private:
+    // Finds the next InstanceHierarchy of a start tag and an end tag, so one of an empty tag is skipped.
+    // Returns false after the end tag of CAEXFile.
+    // Throws AMLException(INVALID_AML_SCHEMA) if the document ends before it, as in the middle of an InstanceHierarchy.
+    bool scan(pair<size_t, size_t>& range)
+    {
+        bool opened = false;
+        XmlToken token;
+        while (!m_ended && m_scanner.next(token))
+        {
+            if (XML_TOKEN_START_TAG == token.type && IsTag(token, "InstanceHierarchy"))
+            {
+                range.first = token.begin - m_aml;
+                opened = true;
+            }
+            else if (XML_TOKEN_END_TAG == token.type && IsTag(token, "InstanceHierarchy") && opened)
+            {
+                range.second = token.end - m_aml;
+                return true;
+            }
+            else if (XML_TOKEN_END_TAG == token.type && IsTag(token, "CAEXFile") && !opened)
+            {
+                m_ended = true;
+            }
+        }
+
+        if (!m_ended)
+        {
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+        return false;
+    }
+
+    shared_ptr<AmlModel> m_model;
+    const char* m_aml;
+    XmlScanner m_scanner;
+    size_t m_headerSize;                        // XML declaration and the start tag of CAEXFile
+    vector<pair<size_t, size_t> > m_ranges;     // InstanceHierarchies found so far
+    size_t m_index;
+    bool m_ended;                               // the end tag of CAEXFile is found
+    string m_doc;
+};
+
+CAMLErrorCode Representation_DataToByteBatch(const representation_t repHandle, const amlObjectHandle_t* amlObjHandles,
+                                             const size_t count, uint8_t** byte, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandles);
+    VERIFY_PARAM_NON_NULL(count);
+    VERIFY_PARAM_NON_NULL(byte);
+    VERIFY_PARAM_NON_NULL(size);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AmlByteBatchFrame frame;
+    const uint8_t version = BATCH_VERSION;
+    try
+    {
+        const string repId = AcquireRepresentation(*model)->getRepresentationId();
+        if (!frame.append(BATCH_MAGIC, BATCH_MAGIC_SIZE) || !frame.append(&version, 1) ||
+            !frame.appendVarint(repId.size()) || !frame.append(repId.data(), repId.size()) ||
+            !frame.appendVarint(count))
+        {
+            return CAML_NO_MEMORY;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            AMLObject* amlObj = amlObjHandles[i] ? FindAmlObj(amlObjHandles[i]) : NULL;
+            if (!amlObj)
+            {
+                return CAML_INVALID_HANDLE;
+            }
+
+            // Representation only converts to a string of its own, which is copied once into the frame.
+            const string amlByte = AcquireRepresentation(*model, *amlObj)->DataToByte(*amlObj);
+            if (!frame.appendVarint(amlByte.size()) || !frame.append(amlByte.data(), amlByte.size()))
+            {
+                return CAML_NO_MEMORY;
+            }
+        }
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    if (!frame.appendCrc())
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *byte = frame.release(size);
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_ByteToDataBatch(const representation_t repHandle, const uint8_t* byte, const size_t size,
+                                             amlBatchIterator_t* iterator)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(byte);
+    VERIFY_PARAM_NON_NULL(size);
+    VERIFY_PARAM_NON_NULL(iterator);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AmlBatchIterator* batchIterator = NULL;
+    try
+    {
+        batchIterator = new AmlByteBatchIterator(model, byte, size);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *iterator = batchIterator;
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_DataToAmlBatch(const representation_t repHandle, const amlObjectHandle_t* amlObjHandles,
+                                            const size_t count, char** amlStr)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandles);
+    VERIFY_PARAM_NON_NULL(count);
+    VERIFY_PARAM_NON_NULL(amlStr);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    // InstanceHierarchies of other AMLObjects follow those of the first one, which keeps the rest of the document.
+    string batch;
+    size_t insertPos = string::npos;
+    string hierarchies;
+    try
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            AMLObject* amlObj = amlObjHandles[i] ? FindAmlObj(amlObjHandles[i]) : NULL;
+            if (!amlObj)
+            {
+                return CAML_INVALID_HANDLE;
+            }
+
+            string aml = ConvertDataToAml(*model, *amlObj);
+
+            XmlScanner scanner(aml.data(), aml.size());
+            XmlToken token;
+            const char* begin = NULL;
+            while (scanner.next(token))
+            {
+                if (XML_TOKEN_START_TAG == token.type && IsTag(token, "InstanceHierarchy"))
+                {
+                    begin = token.begin;
+                }
+                else if (XML_TOKEN_END_TAG == token.type && IsTag(token, "InstanceHierarchy") && begin)
+                {
+                    if (0 == i)
+                    {
+                        insertPos = token.end - aml.data();
+                    }
+                    else
+                    {
+                        hierarchies.append(begin, token.end - begin);
+                    }
+                    begin = NULL;
+                }
+            }
+
+            if (0 == i)
+            {
+                if (string::npos == insertPos)
+                {
+                    return CAML_INVALID_AML_SCHEMA;
+                }
+                batch.swap(aml);
+            }
+        }
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    batch.insert(insertPos, hierarchies);
+
+    char* amlChar = ConvertStringToCharStr(batch);
+    if (NULL == amlChar)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *amlStr = amlChar;
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_AmlToDataBatch(const representation_t repHandle, const char* amlStr,
+                                            amlBatchIterator_t* iterator)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlStr);
+    VERIFY_PARAM_NON_NULL(iterator);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AmlBatchIterator* batchIterator = NULL;
+    try
+    {
+        batchIterator = new AmlXmlBatchIterator(model, amlStr, strlen(amlStr));
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *iterator = batchIterator;
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLBatchIterator_GetCount(const amlBatchIterator_t iterator, size_t* count)
+{
+    VERIFY_PARAM_NON_NULL(iterator);
+    VERIFY_PARAM_NON_NULL(count);
+
+    try
+    {
+        *count = ((AmlBatchIterator*)iterator)->count();
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLBatchIterator_Next(amlBatchIterator_t iterator, amlObjectHandle_t* amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(iterator);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    AMLObject* amlObj = NULL;
+    try
+    {
+        amlObj = ((AmlBatchIterator*)iterator)->next();
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    if (!amlObj)
+    {
+        return CAML_END_OF_BATCH;
+    }
+
+    amlObjectHandle_t amlObjHandleNew = AddAmlObjHandle(amlObj, true);
+    if (!amlObjHandleNew)
+    {
+        delete amlObj;
+        return CAML_NO_MEMORY;
+    }
+
+    *amlObjHandle = amlObjHandleNew;
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLBatchIterator(amlBatchIterator_t iterator)
+{
+    VERIFY_PARAM_NON_NULL(iterator);
+
+    delete (AmlBatchIterator*)iterator;
+
+    return CAML_OK;
+}
+
+// Converts one item of Representation_ConvertBatch(). Input and output of the item are as of the single conversion,
+// except that AMLObject is given in 'amlObj', found or to be registered by the caller for all items at once.
+static CAMLErrorCode ConvertItem(AmlModel& model, CAMLConvertType type, CAMLConvertItem& item, AMLObject*& amlObj)
+{
+    try
+    {
+        if (CAML_CONVERT_DATA_TO_AML == type || CAML_CONVERT_DATA_TO_BYTE == type)
+        {
+            if (!amlObj)
+            {
+                return CAML_INVALID_HANDLE;
+            }
+
+            string converted = (CAML_CONVERT_DATA_TO_AML == type) ? ConvertDataToAml(model, *amlObj) :
+                               AcquireRepresentation(model, *amlObj)->DataToByte(*amlObj);
+            char* str = ConvertStringToCharStr(converted);
+            if (NULL == str)
+            {
+                return CAML_NO_MEMORY;
+            }
+
+            if (CAML_CONVERT_DATA_TO_AML == type)
+            {
+                item.aml = str;
+            }
+            else
+            {
+                item.byte = (uint8_t*)str;
+                item.size = converted.size();
+            }
+            return CAML_OK;
+        }
+
+        if (CAML_CONVERT_AML_TO_DATA == type)
+        {
+            if (!item.aml)
+            {
+                return CAML_INVALID_PARAM;
+            }
+
+            // Each worker thread decodes from a buffer of its own.
+            ScratchBuffer amlString(item.aml, strlen(item.aml));
+            amlObj = ConvertAmlToData(model, amlString.str());
+        }
+        else
+        {
+            if (!item.byte || 0 == item.size)
+            {
+                return CAML_INVALID_PARAM;
+            }
+
+            ScratchBuffer byteString((const char*)item.byte, item.size);
+            amlObj = AcquireFullRepresentation(model)->ByteToData(byteString.str());
+        }
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_ConvertBatch(const representation_t repHandle, const CAMLConvertType type,
+                                          CAMLConvertItem* items, const size_t count)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(items);
+    VERIFY_PARAM_NON_NULL(count);
+    if (CAML_CONVERT_DATA_TO_AML != type && CAML_CONVERT_DATA_TO_BYTE != type &&
+        CAML_CONVERT_AML_TO_DATA != type && CAML_CONVERT_BYTE_TO_DATA != type)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    bool toData = (CAML_CONVERT_AML_TO_DATA == type || CAML_CONVERT_BYTE_TO_DATA == type);
+    vector<AMLObject*> amlObjs;
+    vector<amlObjectHandle_t> handles;
+    try
+    {
+        amlObjs.resize(count);
+        handles.resize(count);
+
+        // Handles are looked up and registered once for the batch, so that workers do not contend on the registry.
+        if (!toData)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                handles[i] = items[i].amlObj;
+            }
+            FindAmlObjs(handles.data(), count, amlObjs.data());
+        }
+
+        AcquireThreadPool()->parallelFor(count, [&](size_t index)
+        {
+            items[index].result = ConvertItem(*model, type, items[index], amlObjs[index]);
+        });
+    }
+    catch (const system_error&)
+    {
+        return CAML_NO_MEMORY;
+    }
+    catch (const bad_alloc&)
+    {
+        // Converted AMLObjects are not given to the caller, since not all items are converted.
+        if (toData)
+        {
+            for (AMLObject* amlObj : amlObjs)
+            {
+                delete amlObj;
+            }
+        }
+        return CAML_NO_MEMORY;
+    }
+
+    if (toData && !AddAmlObjHandles(amlObjs.data(), count, true, handles.data()))
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            delete amlObjs[i];
+            if (CAML_OK == items[i].result)
+            {
+                items[i].result = CAML_NO_MEMORY;
+            }
+        }
+        return CAML_NO_MEMORY;
+    }
+
+    for (size_t i = 0; i < count && toData; i++)
+    {
+        if (CAML_OK == items[i].result)
+        {
+            items[i].amlObj = handles[i];
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (CAML_OK != items[i].result)
+        {
+            return items[i].result;
+        }
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode SetConvertThreadCount(const size_t threads)
+{
+    SetThreadPoolSize(threads);
+
+    return CAML_OK;
+}
+
+CAMLErrorCode GetConvertThreadCount(size_t* threads)
+{
+    VERIFY_PARAM_NON_NULL(threads);
+
+    *threads = GetThreadPoolSize();
+
+    return CAML_OK;
+}
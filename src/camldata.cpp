@@ -67,6 +67,19 @@ CAMLErrorCode DestroyAMLData(amlDataHandle_t amlDataHandle)
     return CAML_OK;
 }
 
+CAMLErrorCode DestroyAMLDataBatch(amlDataHandle_t* amlDataHandles, const size_t count)
+{
+    VERIFY_PARAM_NON_NULL(amlDataHandles);
+    VERIFY_PARAM_NON_NULL(count);
+
+    if (!RemoveAmlDatas(amlDataHandles, count))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    return CAML_OK;
+}
+
 CAMLErrorCode CloneAMLData(amlDataHandle_t origin, amlDataHandle_t* clone)
 {
     VERIFY_PARAM_NON_NULL(origin);
@@ -107,6 +120,11 @@ CAMLErrorCode AMLData_SetValueStr(amlDataHandle_t amlDataHandle, const char* key
         return CAML_INVALID_HANDLE;
     }
 
+    if (IsAmlDataFrozen(amlDataHandle))
+    {
+        return CAML_OBJECT_FROZEN;
+    }
+
     string keyStr(key, strlen(key));
     string valueStr(value, strlen(value));
 
@@ -134,6 +152,11 @@ CAMLErrorCode AMLData_SetValueStrArr(amlDataHandle_t amlDataHandle, const char*
         return CAML_INVALID_HANDLE;
     }
 
+    if (IsAmlDataFrozen(amlDataHandle))
+    {
+        return CAML_OBJECT_FROZEN;
+    }
+
     string keyStr(key, strlen(key));
     vector<string> valueStrArr;
     for (size_t i = 0; i< valueSize; i++)
@@ -167,6 +190,11 @@ CAMLErrorCode AMLData_SetValueAMLData(amlDataHandle_t amlDataHandle, const char*
         return CAML_INVALID_HANDLE;
     }
 
+    if (IsAmlDataFrozen(amlDataHandle))
+    {
+        return CAML_OBJECT_FROZEN;
+    }
+
     string keyStr(key, strlen(key));
 
     try
@@ -358,3 +386,19 @@ CAMLErrorCode AMLData_GetValueType(amlDataHandle_t amlDataHandle, const char* ke
 
     return CAML_OK;
 }
+
+CAMLErrorCode AMLData_GetEstimatedMemoryUsage(amlDataHandle_t amlDataHandle, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(amlDataHandle);
+    VERIFY_PARAM_NON_NULL(size);
+
+    AMLData* amlData = FindAmlData(amlDataHandle);
+    if (!amlData)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    *size = GetAmlDataHandleSize() + EstimateMemoryUsage(*amlData);
+
+    return CAML_OK;
+}
@@ -19,6 +19,11 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <unordered_set>
+#include <unordered_map>
 
 #include "camlhandlemanager.h"
 #include "utlist.h"
@@ -26,30 +31,50 @@
 using namespace std;
 using namespace AML;
 
+typedef struct amlObjectBlock_t {
+    atomic<size_t> liveCount;
+} amlObjectBlock_t;
+
 typedef struct amlObject_t {
     AML::AMLObject* cppObj;
     bool needsDelete;
+    bool inBlock;                       // cppObj is constructed in the storage of 'block'
+    struct amlObjectBlock_t *block;     // NULL if the node is allocated on its own
+    AmlDataIndex* dataIndex;            // built on first access by index
+    bool frozen;
+    bool pinned;                        // owned by the library, so it can't be destroyed
     struct amlObject_t *next;
 } amlObject_t;
 
+#define ALIGN_UP(size, align)   (((size) + (align) - 1) / (align) * (align))
+
 typedef struct amlData_t {
     AML::AMLData* cppObj;
     bool needsDelete;
+    bool frozen;
+    amlDataHandle_t *cachedIn;          // slot of AmlDataIndex::handles which holds this handle, if any
     struct amlData_t *next;
 } amlData_t;
 
 typedef struct amlRep_t {
-    AML::Representation* cppObj;
+    std::shared_ptr<AmlModel> cppObj;   // can be shared by handles of the same model
     struct amlRep_t *next;
 } amlRep_t;
 
+typedef struct amlPatch_t {
+    AMLPatch* cppObj;
+    struct amlPatch_t *next;
+} amlPatch_t;
+
 static amlObject_t *g_amlObjectHead = NULL;
 static amlData_t *g_amlDataHead = NULL;
 static amlRep_t *g_amlRepHead = NULL;
+static amlPatch_t *g_amlPatchHead = NULL;
 
 static mutex g_amlObjectMtx;
 static mutex g_amlDataMtx;
 static mutex g_amlRepMtx;
+static mutex g_amlPatchMtx;
 
 amlObjectHandle_t AddAmlObjHandle(AMLObject* amlObj, bool needsDelete)
 {
@@ -61,6 +86,11 @@ amlObjectHandle_t AddAmlObjHandle(AMLObject* amlObj, bool needsDelete)
 
     node->cppObj = amlObj;
     node->needsDelete = needsDelete;
+    node->inBlock = false;
+    node->block = NULL;
+    node->dataIndex = NULL;
+    node->frozen = false;
+    node->pinned = false;
 
     g_amlObjectMtx.lock();
     LL_APPEND(g_amlObjectHead, node);
@@ -69,6 +99,245 @@ amlObjectHandle_t AddAmlObjHandle(AMLObject* amlObj, bool needsDelete)
     return (amlObjectHandle_t)node;
 }
 
+bool AddAmlObjHandles(size_t count, const function<void(size_t, void*)>& construct, amlObjectHandle_t* handles)
+{
+    assert(count > 0);
+
+    size_t nodesOffset = ALIGN_UP(sizeof(amlObjectBlock_t), alignof(amlObject_t));
+    size_t objsOffset = ALIGN_UP(nodesOffset + count * sizeof(amlObject_t), alignof(AMLObject));
+    char* mem = (char*) malloc(objsOffset + count * sizeof(AMLObject));
+    if (NULL == mem)
+    {
+        return false;
+    }
+
+    amlObjectBlock_t* block = new (mem) amlObjectBlock_t;
+    amlObject_t* nodes = (amlObject_t*)(mem + nodesOffset);
+    AMLObject* objs = (AMLObject*)(mem + objsOffset);
+
+    size_t i = 0;
+    try
+    {
+        for (; i < count; i++)
+        {
+            construct(i, &objs[i]);
+        }
+    }
+    catch (...)
+    {
+        while (i > 0)
+        {
+            objs[--i].~AMLObject();
+        }
+        block->~amlObjectBlock_t();
+        free(mem);
+        throw;
+    }
+
+    block->liveCount = count;
+    for (i = 0; i < count; i++)
+    {
+        nodes[i].cppObj = &objs[i];
+        nodes[i].needsDelete = true;
+        nodes[i].inBlock = true;
+        nodes[i].block = block;
+        nodes[i].dataIndex = NULL;
+        nodes[i].frozen = false;
+        nodes[i].pinned = false;
+        handles[i] = (amlObjectHandle_t)&nodes[i];
+    }
+
+    g_amlObjectMtx.lock();
+    for (i = 0; i < count; i++)
+    {
+        LL_PREPEND(g_amlObjectHead, &nodes[i]);
+    }
+    g_amlObjectMtx.unlock();
+
+    return true;
+}
+
+bool AddAmlObjHandles(AMLObject* const* amlObjs, size_t count, bool needsDelete, amlObjectHandle_t* handles)
+{
+    amlObject_t* nodes = NULL;
+    for (size_t i = 0; i < count; i++)
+    {
+        handles[i] = NULL;
+        if (NULL == amlObjs[i])
+        {
+            continue;
+        }
+
+        amlObject_t* node = (amlObject_t*) malloc(sizeof(amlObject_t));
+        if (NULL == node)
+        {
+            while (nodes)
+            {
+                amlObject_t* next = nodes->next;
+                free(nodes);
+                nodes = next;
+            }
+            return false;
+        }
+
+        node->cppObj = amlObjs[i];
+        node->needsDelete = needsDelete;
+        node->inBlock = false;
+        node->block = NULL;
+        node->dataIndex = NULL;
+        node->frozen = false;
+        node->pinned = false;
+        node->next = nodes;
+        nodes = node;
+        handles[i] = (amlObjectHandle_t)node;
+    }
+
+    g_amlObjectMtx.lock();
+    while (nodes)
+    {
+        amlObject_t* next = nodes->next;
+        LL_PREPEND(g_amlObjectHead, nodes);
+        nodes = next;
+    }
+    g_amlObjectMtx.unlock();
+
+    return true;
+}
+
+static void CollectAmlData(const AMLData& amlData, unordered_set<const AMLData*>& datas)
+{
+    datas.insert(&amlData);
+
+    vector<string> keys = amlData.getKeys();
+    for (const string& key : keys)
+    {
+        if (AMLValueType::AMLData == amlData.getValueType(key))
+        {
+            CollectAmlData(amlData.getValueToAMLData(key), datas);
+        }
+    }
+}
+
+static void CollectOwnedAmlData(const AMLData& amlData, unordered_set<const AMLData*>& datas)
+{
+    vector<string> keys = amlData.getKeys();
+    for (const string& key : keys)
+    {
+        if (AMLValueType::AMLData == amlData.getValueType(key))
+        {
+            CollectAmlData(amlData.getValueToAMLData(key), datas);
+        }
+    }
+}
+
+static void CollectOwnedAmlData(const AMLObject& amlObj, unordered_set<const AMLData*>& datas)
+{
+    vector<string> dataNames = amlObj.getDataNames();
+    for (const string& name : dataNames)
+    {
+        CollectAmlData(amlObj.getData(name), datas);
+    }
+}
+
+// Should be called with g_amlDataMtx held.
+static void UncacheAmlData(amlData_t* amlData)
+{
+    if (amlData->cachedIn)
+    {
+        *amlData->cachedIn = NULL;
+        amlData->cachedIn = NULL;
+    }
+}
+
+static void DeleteAmlDataIndex(AmlDataIndex* index)
+{
+    if (NULL == index)
+    {
+        return;
+    }
+
+    g_amlDataMtx.lock();
+    for (amlDataHandle_t handle : index->handles)
+    {
+        if (handle)
+        {
+            ((amlData_t*)handle)->cachedIn = NULL;
+        }
+    }
+    g_amlDataMtx.unlock();
+
+    delete index;
+}
+
+// Removes the handles of 'datas' in one critical section, and frees them after it.
+static void RemoveAmlDataHandles(const unordered_set<const AMLData*>& datas)
+{
+    if (datas.empty())
+    {
+        return;
+    }
+
+    amlData_t *removed = NULL;
+
+    g_amlDataMtx.lock();
+    amlData_t **link = &g_amlDataHead;
+    while (*link)
+    {
+        amlData_t *node = *link;
+        if (datas.count(node->cppObj))
+        {
+            UncacheAmlData(node);
+            *link = node->next;
+            node->next = removed;
+            removed = node;
+        }
+        else
+        {
+            link = &node->next;
+        }
+    }
+    g_amlDataMtx.unlock();
+
+    while (removed)
+    {
+        amlData_t *node = removed;
+        removed = node->next;
+        if (node->needsDelete)
+        {
+            delete node->cppObj;
+        }
+        free(node);
+    }
+}
+
+static void ReleaseAmlObj(amlObject_t* amlObj)
+{
+    DeleteAmlDataIndex(amlObj->dataIndex);
+
+    if (amlObj->needsDelete)
+    {
+        if (amlObj->inBlock)
+        {
+            amlObj->cppObj->~AMLObject();
+        }
+        else
+        {
+            delete amlObj->cppObj;
+        }
+    }
+
+    amlObjectBlock_t* block = amlObj->block;
+    if (NULL == block)
+    {
+        free(amlObj);
+    }
+    else if (1 == block->liveCount--)
+    {
+        block->~amlObjectBlock_t();
+        free(block);
+    }
+}
+
 void RemoveAmlObj(amlObjectHandle_t handle)
 {
     assert(handle);
@@ -79,12 +348,65 @@ void RemoveAmlObj(amlObjectHandle_t handle)
     LL_DELETE(g_amlObjectHead, amlObj);
     g_amlObjectMtx.unlock();
 
-    if (amlObj->needsDelete)
+    ReleaseAmlObj(amlObj);
+    amlObj = NULL;
+}
+
+bool RemoveAmlObjs(amlObjectHandle_t* handles, size_t count)
+{
+    unordered_set<amlObject_t*> targets;
+    for (size_t i = 0; i < count; i++)
     {
-        delete amlObj->cppObj;
+        targets.insert((amlObject_t*)handles[i]);
     }
-    free(amlObj);
-    amlObj = NULL;
+    if (targets.size() != count)
+    {
+        return false;
+    }
+
+    g_amlObjectMtx.lock();
+    size_t found = 0;
+    amlObject_t *node = NULL;
+    LL_FOREACH(g_amlObjectHead, node)
+    {
+        if (!node->pinned)
+        {
+            found += targets.count(node);
+        }
+    }
+    if (found != count)
+    {
+        g_amlObjectMtx.unlock();
+        return false;
+    }
+
+    amlObject_t **link = &g_amlObjectHead;
+    while (*link)
+    {
+        if (targets.count(*link))
+        {
+            *link = (*link)->next;
+        }
+        else
+        {
+            link = &(*link)->next;
+        }
+    }
+    g_amlObjectMtx.unlock();
+
+    unordered_set<const AMLData*> datas;
+    for (size_t i = 0; i < count; i++)
+    {
+        CollectOwnedAmlData(*((amlObject_t*)handles[i])->cppObj, datas);
+    }
+    RemoveAmlDataHandles(datas);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ReleaseAmlObj((amlObject_t*)handles[i]);
+    }
+
+    return true;
 }
 
 AMLObject* FindAmlObj(amlObjectHandle_t handle)
@@ -108,6 +430,194 @@ AMLObject* FindAmlObj(amlObjectHandle_t handle)
     return NULL;
 }
 
+void FindAmlObjs(const amlObjectHandle_t* handles, size_t count, AMLObject** amlObjs)
+{
+    unordered_map<amlObject_t*, AMLObject*> found;
+    found.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        found.emplace((amlObject_t*)handles[i], (AMLObject*)NULL);
+    }
+
+    // One pass over the registry, instead of one for each handle.
+    amlObject_t *node = NULL;
+    g_amlObjectMtx.lock();
+    LL_FOREACH(g_amlObjectHead, node)
+    {
+        unordered_map<amlObject_t*, AMLObject*>::iterator it = found.find(node);
+        if (it != found.end())
+        {
+            it->second = node->cppObj;
+        }
+    }
+    g_amlObjectMtx.unlock();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        amlObjs[i] = found[(amlObject_t*)handles[i]];
+    }
+}
+
+size_t GetAmlObjHandleSize(void)
+{
+    return sizeof(amlObject_t);
+}
+
+const AmlDataIndex* GetAmlDataIndex(amlObjectHandle_t handle)
+{
+    amlObject_t *target = (amlObject_t*)handle;
+    amlObject_t *node = NULL;
+
+    lock_guard<mutex> lock(g_amlObjectMtx);
+    LL_FOREACH(g_amlObjectHead, node)
+    {
+        if (node == target)
+        {
+            break;
+        }
+    }
+
+    if (NULL == node)
+    {
+        return NULL;
+    }
+
+    if (NULL == node->dataIndex)
+    {
+        unique_ptr<AmlDataIndex> index(new AmlDataIndex());
+        index->names = node->cppObj->getDataNames();
+        index->datas.reserve(index->names.size());
+        for (const string& name : index->names)
+        {
+            index->datas.push_back(&node->cppObj->getData(name));
+        }
+        index->handles.resize(index->names.size(), NULL);
+        node->dataIndex = index.release();
+    }
+
+    return node->dataIndex;
+}
+
+void ResetAmlDataIndex(amlObjectHandle_t handle)
+{
+    amlObject_t *node = (amlObject_t*)handle;
+
+    g_amlObjectMtx.lock();
+    AmlDataIndex* oldIndex = node->dataIndex;
+    node->dataIndex = NULL;
+    g_amlObjectMtx.unlock();
+
+    DeleteAmlDataIndex(oldIndex);
+}
+
+amlDataHandle_t ResolveAmlDataHandle(const AmlDataIndex* index, size_t position)
+{
+    lock_guard<mutex> lock(g_amlDataMtx);
+
+    amlDataHandle_t& slot = index->handles[position];
+    if (slot)
+    {
+        return slot;
+    }
+
+    AMLData* amlData = const_cast<AMLData*>(index->datas[position]);
+    amlData_t *node = NULL;
+    LL_FOREACH(g_amlDataHead, node)
+    {
+        if (node->cppObj == amlData)
+        {
+            break;
+        }
+    }
+
+    if (NULL == node)
+    {
+        node = (amlData_t*) malloc(sizeof(amlData_t));
+        if (NULL == node)
+        {
+            return NULL;
+        }
+
+        node->cppObj = amlData;
+        node->needsDelete = false;
+        node->frozen = false;
+        node->cachedIn = NULL;
+        LL_PREPEND(g_amlDataHead, node);
+    }
+
+    UncacheAmlData(node);
+    node->cachedIn = &slot;
+    slot = (amlDataHandle_t)node;
+
+    return slot;
+}
+
+bool FreezeAmlObj(amlObjectHandle_t handle)
+{
+    const AmlDataIndex* index = GetAmlDataIndex(handle);
+    if (NULL == index)
+    {
+        return false;
+    }
+
+    unordered_set<const AMLData*> datas;
+    for (const AMLData* amlData : index->datas)
+    {
+        CollectAmlData(*amlData, datas);
+    }
+
+    // Register every AMLData of the subtree up front, so that readers only look handles up.
+    g_amlDataMtx.lock();
+    amlData_t *node = NULL;
+    LL_FOREACH(g_amlDataHead, node)
+    {
+        if (datas.erase(node->cppObj))
+        {
+            node->frozen = true;
+        }
+    }
+    for (const AMLData* amlData : datas)
+    {
+        node = (amlData_t*) malloc(sizeof(amlData_t));
+        if (NULL == node)
+        {
+            g_amlDataMtx.unlock();
+            return false;
+        }
+
+        node->cppObj = const_cast<AMLData*>(amlData);
+        node->needsDelete = false;
+        node->frozen = true;
+        node->cachedIn = NULL;
+        LL_PREPEND(g_amlDataHead, node);
+    }
+    g_amlDataMtx.unlock();
+
+    g_amlObjectMtx.lock();
+    ((amlObject_t*)handle)->frozen = true;
+    g_amlObjectMtx.unlock();
+
+    return true;
+}
+
+bool IsAmlObjFrozen(amlObjectHandle_t handle)
+{
+    lock_guard<mutex> lock(g_amlObjectMtx);
+    return ((amlObject_t*)handle)->frozen;
+}
+
+void PinAmlObj(amlObjectHandle_t handle)
+{
+    lock_guard<mutex> lock(g_amlObjectMtx);
+    ((amlObject_t*)handle)->pinned = true;
+}
+
+bool IsAmlObjPinned(amlObjectHandle_t handle)
+{
+    lock_guard<mutex> lock(g_amlObjectMtx);
+    return ((amlObject_t*)handle)->pinned;
+}
+
 amlDataHandle_t AddAmlDataHandle(AMLData* amlData, bool needsDelete)
 {
     amlData_t* node = (amlData_t*) malloc(sizeof(amlData_t));
@@ -118,6 +628,8 @@ amlDataHandle_t AddAmlDataHandle(AMLData* amlData, bool needsDelete)
 
     node->cppObj = amlData;
     node->needsDelete = needsDelete;
+    node->frozen = false;
+    node->cachedIn = NULL;
 
     g_amlDataMtx.lock();
     LL_APPEND(g_amlDataHead, node);
@@ -134,6 +646,7 @@ void RemoveAmlData(amlDataHandle_t handle)
 
     g_amlDataMtx.lock();
     LL_DELETE(g_amlDataHead, amlData);
+    UncacheAmlData(amlData);
     g_amlDataMtx.unlock();
 
     if (amlData->needsDelete)
@@ -144,31 +657,64 @@ void RemoveAmlData(amlDataHandle_t handle)
     amlData = NULL;
 }
 
-void RemoveAmlData(AMLData* amlData)
+bool RemoveAmlDatas(amlDataHandle_t* handles, size_t count)
 {
-    assert(amlData);
-
-    amlData_t *target = NULL;
+    unordered_set<amlData_t*> targets;
+    for (size_t i = 0; i < count; i++)
+    {
+        targets.insert((amlData_t*)handles[i]);
+    }
+    if (targets.size() != count)
+    {
+        return false;
+    }
 
     g_amlDataMtx.lock();
-    LL_FOREACH(g_amlDataHead, target)
+    size_t found = 0;
+    amlData_t *node = NULL;
+    LL_FOREACH(g_amlDataHead, node)
     {
-        if (target->cppObj == amlData)
+        found += targets.count(node);
+    }
+    if (found != count)
+    {
+        g_amlDataMtx.unlock();
+        return false;
+    }
+
+    amlData_t **link = &g_amlDataHead;
+    while (*link)
+    {
+        if (targets.count(*link))
         {
-            if (target->needsDelete)
-            {
-                delete target->cppObj;
-            }
+            UncacheAmlData(*link);
+            *link = (*link)->next;
+        }
+        else
+        {
+            link = &(*link)->next;
+        }
+    }
+    g_amlDataMtx.unlock();
 
-            LL_DELETE(g_amlDataHead, target);
-            free(target);
-            target = NULL;
+    unordered_set<const AMLData*> datas;
+    for (size_t i = 0; i < count; i++)
+    {
+        CollectOwnedAmlData(*((amlData_t*)handles[i])->cppObj, datas);
+    }
+    RemoveAmlDataHandles(datas);
 
-            g_amlDataMtx.unlock();
-            return;
+    for (size_t i = 0; i < count; i++)
+    {
+        amlData_t* amlData = (amlData_t*)handles[i];
+        if (amlData->needsDelete)
+        {
+            delete amlData->cppObj;
         }
+        free(amlData);
     }
-    g_amlDataMtx.unlock();
+
+    return true;
 }
 
 AMLData* FindAmlData(amlDataHandle_t handle)
@@ -207,15 +753,27 @@ amlDataHandle_t* FindAmlDataHandle(AMLData* amlData)
     return NULL;
 }
 
-representation_t AddRepresentationHandle(Representation* rep)
+bool IsAmlDataFrozen(amlDataHandle_t handle)
+{
+    lock_guard<mutex> lock(g_amlDataMtx);
+    return ((amlData_t*)handle)->frozen;
+}
+
+size_t GetAmlDataHandleSize(void)
+{
+    return sizeof(amlData_t);
+}
+
+representation_t AddRepresentationHandle(const shared_ptr<AmlModel>& model)
 {
-    amlRep_t* node = (amlRep_t*) malloc(sizeof(amlRep_t));
+    amlRep_t* node = new(std::nothrow) amlRep_t;
     if (NULL == node)
     {
         return NULL;
     }
 
-    node->cppObj = rep;
+    node->cppObj = model;
+    node->next = NULL;
 
     g_amlRepMtx.lock();
     LL_APPEND(g_amlRepHead, node);
@@ -234,12 +792,11 @@ void RemoveRepresentation(representation_t handle)
     LL_DELETE(g_amlRepHead, rep);
     g_amlRepMtx.unlock();
 
-    delete rep->cppObj;
-    free(rep);
+    delete rep;
     rep = NULL;
 }
 
-Representation* FindRepresentation(representation_t handle)
+shared_ptr<Representation> FindRepresentation(representation_t handle)
 {
     amlRep_t *target = (amlRep_t*)handle;
     amlRep_t *node = NULL;
@@ -249,38 +806,117 @@ Representation* FindRepresentation(representation_t handle)
     {
         if (node == target)
         {
+            shared_ptr<Representation> rep = AcquireRepresentation(*node->cppObj);
             g_amlRepMtx.unlock();
-            return node->cppObj;
+            return rep;
         }
     }
     g_amlRepMtx.unlock();
 
-    return NULL;
+    return shared_ptr<Representation>();
 }
 
-void RemoveOwnedAmlDataHandles(AMLData* amlData)
+bool ReplaceAmlModel(representation_t handle, const shared_ptr<AmlModel>& model)
 {
-    vector<string> keys = amlData->getKeys();
-    for (string key : keys)
+    amlRep_t *target = (amlRep_t*)handle;
+    amlRep_t *node = NULL;
+    shared_ptr<AmlModel> old;
+
     {
-        AMLValueType type = amlData->getValueType(key);
-        if (AMLValueType::AMLData == type)
+        lock_guard<mutex> lock(g_amlRepMtx);
+        LL_FOREACH(g_amlRepHead, node)
         {
-            AMLData ownedAmlData = amlData->getValueToAMLData(key);
-            RemoveOwnedAmlDataHandles(&ownedAmlData);
-            RemoveAmlData(&ownedAmlData);
+            if (node == target)
+            {
+                old = node->cppObj;
+                node->cppObj = model;
+                break;
+            }
         }
     }
+
+    // The old model is released here, or by the last call still using it.
+    return (NULL != node);
 }
 
-void RemoveOwnedAmlDataHandles(AMLObject* amlObj)
+shared_ptr<AmlModel> FindAmlModel(representation_t handle)
+{
+    amlRep_t *target = (amlRep_t*)handle;
+    amlRep_t *node = NULL;
+
+    lock_guard<mutex> lock(g_amlRepMtx);
+    LL_FOREACH(g_amlRepHead, node)
+    {
+        if (node == target)
+        {
+            return node->cppObj;
+        }
+    }
+
+    return shared_ptr<AmlModel>();
+}
+
+amlPatchHandle_t AddAmlPatchHandle(AMLPatch* patch)
+{
+    amlPatch_t* node = (amlPatch_t*) malloc(sizeof(amlPatch_t));
+    if (NULL == node)
+    {
+        return NULL;
+    }
+
+    node->cppObj = patch;
+
+    g_amlPatchMtx.lock();
+    LL_APPEND(g_amlPatchHead, node);
+    g_amlPatchMtx.unlock();
+
+    return (amlPatchHandle_t)node;
+}
+
+void RemoveAmlPatch(amlPatchHandle_t handle)
 {
-    vector<string> dataNames = amlObj->getDataNames();
+    assert(handle);
+
+    amlPatch_t* patch = (amlPatch_t*)handle;
+
+    g_amlPatchMtx.lock();
+    LL_DELETE(g_amlPatchHead, patch);
+    g_amlPatchMtx.unlock();
+
+    delete patch->cppObj;
+    free(patch);
+    patch = NULL;
+}
 
-    for (string name : dataNames)
+AMLPatch* FindAmlPatch(amlPatchHandle_t handle)
+{
+    amlPatch_t *target = (amlPatch_t*)handle;
+    amlPatch_t *node = NULL;
+
+    g_amlPatchMtx.lock();
+    LL_FOREACH(g_amlPatchHead, node)
     {
-        AMLData ownedAmlData = amlObj->getData(name);
-        RemoveOwnedAmlDataHandles(&ownedAmlData);
-        RemoveAmlData(&ownedAmlData);
+        if (node == target)
+        {
+            g_amlPatchMtx.unlock();
+            return node->cppObj;
+        }
     }
+    g_amlPatchMtx.unlock();
+
+    return NULL;
+}
+
+void RemoveOwnedAmlDataHandles(AMLData* amlData)
+{
+    unordered_set<const AMLData*> datas;
+    CollectOwnedAmlData(*amlData, datas);
+    RemoveAmlDataHandles(datas);
+}
+
+void RemoveOwnedAmlDataHandles(AMLObject* amlObj)
+{
+    unordered_set<const AMLData*> datas;
+    CollectOwnedAmlData(*amlObj, datas);
+    RemoveAmlDataHandles(datas);
 }
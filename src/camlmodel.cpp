@@ -0,0 +1,459 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <set>
+#include <map>
+#include <mutex>
+
+#include "Representation.h"
+#include "AMLException.h"
+
+#include "camlmodel.h"
+#include "camlxmlscanner.h"
+#include "camlutils.h"
+
+using namespace std;
+using namespace AML;
+
+// SystemUnitClass for the header of AMLObject, which is always loaded.
+#define EVENT_CLASS_NAME    "Event"
+
+// SystemUnitClassLib name and SystemUnitClass name
+typedef std::pair<std::string, std::string> AmlClassKey;
+
+/**
+ * Offsets of SystemUnitClasses in an AML file which is mapped to memory.
+ * A lazy model is loaded from the file without the SystemUnitClasses that are not used yet.
+ * Classes of the same name in different libraries are loaded together, since AMLData only tells the name.
+ */
+struct AmlLazyIndex
+{
+    const char* source;
+    size_t size;
+    std::map<AmlClassKey, std::pair<size_t, size_t>> classes;   // [begin, end), not changed after indexing
+    std::set<std::string> names;                                // names of 'classes', not changed after indexing
+    std::shared_ptr<const std::set<std::string>> loaded;        // names loaded to the Representation
+    std::mutex mtx;                                             // held while classes are loaded
+
+    AmlLazyIndex() : source(NULL), size(0) {}
+    ~AmlLazyIndex()
+    {
+        if (source)
+        {
+            munmap((void*)source, size);
+        }
+    }
+};
+
+// Anonymous file in memory, so that a model in memory never reaches a file system.
+static int CreateModelFile(void)
+{
+#ifdef SYS_memfd_create
+    return syscall(SYS_memfd_create, "caml_model", 1 /* MFD_CLOEXEC */);
+#else
+    return -1;
+#endif
+}
+
+// Temporary file for a kernel without memfd or a system without /proc. It should be unlinked after use.
+static int CreateTemporaryModelFile(char* path, size_t size)
+{
+    const char* dir = getenv("TMPDIR");
+    if (NULL == dir || '\0' == dir[0])
+    {
+        dir = "/tmp";
+    }
+
+    int length = snprintf(path, size, "%s/caml_model_XXXXXX", dir);
+    if (length < 0 || (size_t)length >= size)
+    {
+        return -1;
+    }
+
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    return fd;
+}
+
+// Representation only loads a model from a path, so the buffer is exposed through a file descriptor.
+// Throws AMLException(INVALID_FILE_PATH) if neither a file in memory nor a temporary file can be made.
+static Representation* NewRepresentationFromBuffer(const char* buffer, size_t size)
+{
+    char path[PATH_MAX];
+    bool temporary = false;
+
+    int fd = CreateModelFile();
+    if (fd >= 0)
+    {
+        snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+        if (0 != access(path, R_OK))
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0)
+    {
+        fd = CreateTemporaryModelFile(path, sizeof(path));
+        if (fd < 0)
+        {
+            throw AMLException(INVALID_FILE_PATH);
+        }
+        temporary = true;
+    }
+
+    try
+    {
+        if (!WriteAll(fd, buffer, size))
+        {
+            throw AMLException(temporary ? INVALID_FILE_PATH : NO_MEMORY);
+        }
+
+        Representation* rep = new Representation(path);
+        if (temporary)
+        {
+            unlink(path);
+        }
+        close(fd);
+        return rep;
+    }
+    catch (...)
+    {
+        if (temporary)
+        {
+            unlink(path);
+        }
+        close(fd);
+        throw;
+    }
+}
+
+AmlModel* LoadAmlModel(const string& path)
+{
+    unique_ptr<AmlModel> model(new AmlModel());
+    model->rep.reset(new Representation(path));
+
+    return model.release();
+}
+
+AmlModel* LoadAmlModelFromBuffer(const char* buffer, size_t size, bool keepSource)
+{
+    unique_ptr<AmlModel> model(new AmlModel());
+    model->rep.reset(NewRepresentationFromBuffer(buffer, size));
+    if (keepSource)
+    {
+        model->source.assign(buffer, size);
+    }
+
+    return model.release();
+}
+
+static void IndexClasses(AmlLazyIndex& index)
+{
+    XmlScanner scanner(index.source, index.size);
+    XmlToken token;
+    size_t depth = 0;
+    size_t libDepth = 0;            // depth of the SystemUnitClassLib being scanned, 0 if none
+    string libName;
+    size_t classBegin = 0;
+    string className;
+
+    while (scanner.next(token))
+    {
+        if (XML_TOKEN_START_TAG != token.type && XML_TOKEN_EMPTY_TAG != token.type &&
+            XML_TOKEN_END_TAG != token.type)
+        {
+            continue;
+        }
+
+        string name(token.name, token.nameSize);
+        if (XML_TOKEN_END_TAG == token.type)
+        {
+            if (libDepth && depth == libDepth + 1 && "SystemUnitClass" == name && !className.empty())
+            {
+                index.classes[make_pair(libName, className)] = make_pair(classBegin, (size_t)(token.end - index.source));
+                index.names.insert(className);
+                className.clear();
+            }
+            else if (depth == libDepth && "SystemUnitClassLib" == name)
+            {
+                libDepth = 0;
+            }
+            depth--;
+            continue;
+        }
+
+        if (XML_TOKEN_START_TAG == token.type)
+        {
+            depth++;
+            if (!libDepth && "SystemUnitClassLib" == name)
+            {
+                libDepth = depth;
+                libName.clear();
+                GetXmlAttribute(token, "Name", libName);
+            }
+            else if (libDepth && depth == libDepth + 1 && "SystemUnitClass" == name &&
+                     GetXmlAttribute(token, "Name", className))
+            {
+                classBegin = token.begin - index.source;
+            }
+        }
+        else if (libDepth && depth == libDepth && "SystemUnitClass" == name)
+        {
+            string emptyClass;
+            if (GetXmlAttribute(token, "Name", emptyClass))
+            {
+                index.classes[make_pair(libName, emptyClass)] = make_pair((size_t)(token.begin - index.source),
+                                                                          (size_t)(token.end - index.source));
+                index.names.insert(emptyClass);
+            }
+        }
+    }
+}
+
+// Loads the model with the SystemUnitClasses in 'loaded' only.
+static Representation* NewRepresentationOfClasses(const AmlLazyIndex& index, const set<string>& loaded)
+{
+    string document;
+    document.reserve(index.size);
+
+    // Ranges of classes do not overlap, but the index is ordered by name, not by offset.
+    vector<pair<size_t, size_t>> skipped;
+    for (map<AmlClassKey, pair<size_t, size_t>>::const_iterator it = index.classes.begin(); it != index.classes.end(); ++it)
+    {
+        if (!loaded.count(it->first.second))
+        {
+            skipped.push_back(it->second);
+        }
+    }
+    sort(skipped.begin(), skipped.end());
+
+    size_t pos = 0;
+    for (size_t i = 0; i < skipped.size(); i++)
+    {
+        document.append(index.source + pos, skipped[i].first - pos);
+        pos = skipped[i].second;
+    }
+    document.append(index.source + pos, index.size - pos);
+
+    return NewRepresentationFromBuffer(document.data(), document.size());
+}
+
+AmlModel* LoadLazyAmlModel(const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw AMLException(INVALID_FILE_PATH);
+    }
+
+    struct stat st;
+    if (0 != fstat(fd, &st) || 0 == st.st_size)
+    {
+        close(fd);
+        throw AMLException(INVALID_AML_SCHEMA);
+    }
+
+    void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapped)
+    {
+        throw AMLException(NO_MEMORY);
+    }
+
+    shared_ptr<AmlLazyIndex> index = make_shared<AmlLazyIndex>();
+    index->source = (const char*)mapped;
+    index->size = st.st_size;
+    IndexClasses(*index);
+
+    shared_ptr<set<string>> loaded = make_shared<set<string>>();
+    if (index->names.count(EVENT_CLASS_NAME))
+    {
+        loaded->insert(EVENT_CLASS_NAME);
+    }
+    index->loaded = loaded;
+
+    unique_ptr<AmlModel> model(new AmlModel());
+    model->rep.reset(NewRepresentationOfClasses(*index, *loaded));
+    model->lazy = index;
+
+    return model.release();
+}
+
+shared_ptr<Representation> AcquireRepresentation(const AmlModel& model)
+{
+    return atomic_load(&model.rep);
+}
+
+// Whether any of the SystemUnitClasses of 'names', or of the model if 'names' is NULL, is not in 'loaded'.
+static bool HasMissingClass(const AmlLazyIndex& index, const set<string>& loaded, const vector<string>* names)
+{
+    if (NULL == names)
+    {
+        return loaded.size() != index.names.size();
+    }
+
+    for (const string& name : *names)
+    {
+        if (!loaded.count(name) && index.names.count(name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Makes the Representation of a lazy model have the SystemUnitClasses of 'names', or all of them if 'names' is NULL.
+static shared_ptr<Representation> LoadClasses(AmlModel& model, const vector<string>* names)
+{
+    AmlLazyIndex& index = *model.lazy;
+
+    // The loaded classes are stored after the Representation which has them,
+    // so a Representation read after them has at least those classes.
+    if (!HasMissingClass(index, *atomic_load(&index.loaded), names))
+    {
+        return atomic_load(&model.rep);
+    }
+
+    lock_guard<mutex> lock(index.mtx);
+
+    shared_ptr<const set<string>> current = atomic_load(&index.loaded);
+    if (!HasMissingClass(index, *current, names))
+    {
+        return atomic_load(&model.rep);
+    }
+
+    shared_ptr<set<string>> loaded = make_shared<set<string>>(*current);
+    if (NULL == names)
+    {
+        loaded->insert(index.names.begin(), index.names.end());
+    }
+    else
+    {
+        for (const string& name : *names)
+        {
+            if (index.names.count(name))
+            {
+                loaded->insert(name);
+            }
+        }
+    }
+
+    shared_ptr<Representation> rep(NewRepresentationOfClasses(index, *loaded));
+    atomic_store(&model.rep, rep);
+    atomic_store(&index.loaded, shared_ptr<const set<string>>(loaded));
+
+    return rep;
+}
+
+shared_ptr<Representation> AcquireRepresentation(AmlModel& model, const AMLObject& amlObj)
+{
+    if (!model.lazy)
+    {
+        return AcquireRepresentation(model);
+    }
+
+    vector<string> names = amlObj.getDataNames();
+    return LoadClasses(model, &names);
+}
+
+// AMLData of AMLObject are InternalElements named after their SystemUnitClasses.
+static vector<string> GetInternalElementNames(const string& aml)
+{
+    vector<string> names;
+    XmlScanner scanner(aml.data(), aml.size());
+    XmlToken token;
+    while (scanner.next(token))
+    {
+        string name;
+        if ((XML_TOKEN_START_TAG == token.type || XML_TOKEN_EMPTY_TAG == token.type) &&
+            token.nameSize == strlen("InternalElement") && 0 == memcmp(token.name, "InternalElement", token.nameSize) &&
+            GetXmlAttribute(token, "Name", name))
+        {
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+AMLObject* ConvertAmlToData(AmlModel& model, const string& aml)
+{
+    shared_ptr<Representation> rep = AcquireRepresentation(model);
+    if (!model.lazy)
+    {
+        return rep->AmlToData(aml);
+    }
+
+    try
+    {
+        return rep->AmlToData(aml);
+    }
+    catch (const AMLException&)
+    {
+        // The document is scanned for its SystemUnitClasses only if the loaded ones are not enough.
+        vector<string> names = GetInternalElementNames(aml);
+        shared_ptr<Representation> loaded = LoadClasses(model, &names);
+        if (loaded == rep)
+        {
+            throw;
+        }
+        return loaded->AmlToData(aml);
+    }
+}
+
+shared_ptr<Representation> AcquireFullRepresentation(AmlModel& model)
+{
+    if (!model.lazy)
+    {
+        return AcquireRepresentation(model);
+    }
+
+    return LoadClasses(model, NULL);
+}
+
+string ConvertDataToAml(AmlModel& model, const AMLObject& amlObj)
+{
+    // The document has the SystemUnitClassLib of the model, which should not depend on the classes used so far.
+    return AcquireFullRepresentation(model)->DataToAml(amlObj);
+}
+
+bool GetLoadedClassCount(const AmlModel& model, size_t* loaded, size_t* total)
+{
+    if (!model.lazy)
+    {
+        return false;
+    }
+
+    *loaded = atomic_load(&model.lazy->loaded)->size();
+    *total = model.lazy->names.size();
+    return true;
+}
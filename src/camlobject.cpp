@@ -19,6 +19,7 @@
 #include <map>
 #include <vector>
 #include <cstring>
+#include <new>
 
 #include "AMLInterface.h"
 #include "AMLException.h"
@@ -86,12 +87,42 @@ CAMLErrorCode CreateAMLObjectWithID(const char* deviceId, const char* timeStamp,
     return CAML_OK;
 }
 
+CAMLErrorCode CreateAMLObjectWithEpoch(const char* deviceId, const int64_t epoch, amlObjectHandle_t* amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(deviceId);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    if (epoch < 0)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    AMLObject* amlObj = nullptr;
+    try
+    {
+        amlObj = new AMLObject(deviceId, FormatEpoch(epoch));
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    amlObjectHandle_t handle = AddAmlObjHandle(amlObj, true);
+    if (!handle)
+    {
+        delete amlObj;
+        return CAML_NO_MEMORY;
+    }
+
+    *amlObjHandle = handle;
+    return CAML_OK;
+}
+
 CAMLErrorCode DestroyAMLObject(amlObjectHandle_t amlObjHandle)
 {
     VERIFY_PARAM_NON_NULL(amlObjHandle);
 
     AMLObject* amlObj = FindAmlObj(amlObjHandle);
-    if (!amlObj)
+    if (!amlObj || IsAmlObjPinned(amlObjHandle))
     {
         return CAML_INVALID_HANDLE;
     }
@@ -102,6 +133,52 @@ CAMLErrorCode DestroyAMLObject(amlObjectHandle_t amlObjHandle)
     return CAML_OK;
 }
 
+CAMLErrorCode CreateAMLObjects(const char** deviceIds, const char** timeStamps, const size_t count, amlObjectHandle_t* amlObjHandles)
+{
+    VERIFY_PARAM_NON_NULL(deviceIds);
+    VERIFY_PARAM_NON_NULL(timeStamps);
+    VERIFY_PARAM_NON_NULL(count);
+    VERIFY_PARAM_NON_NULL(amlObjHandles);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        VERIFY_PARAM_NON_NULL(deviceIds[i]);
+        VERIFY_PARAM_NON_NULL(timeStamps[i]);
+    }
+
+    try
+    {
+        bool added = AddAmlObjHandles(count, [&](size_t i, void* storage)
+        {
+            new (storage) AMLObject(deviceIds[i], timeStamps[i]);
+        }, amlObjHandles);
+
+        if (!added)
+        {
+            return CAML_NO_MEMORY;
+        }
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLObjects(amlObjectHandle_t* amlObjHandles, const size_t count)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandles);
+    VERIFY_PARAM_NON_NULL(count);
+
+    if (!RemoveAmlObjs(amlObjHandles, count))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    return CAML_OK;
+}
+
 CAMLErrorCode CloneAMLObject(amlObjectHandle_t origin, amlObjectHandle_t* clone)
 {
     VERIFY_PARAM_NON_NULL(origin);
@@ -147,6 +224,11 @@ CAMLErrorCode AMLObject_AddData(amlObjectHandle_t amlObjHandle, const char* name
         return CAML_INVALID_HANDLE;
     }
 
+    if (IsAmlObjFrozen(amlObjHandle))
+    {
+        return CAML_OBJECT_FROZEN;
+    }
+
     try
     {
         amlObj->addData(name, *amlData);
@@ -156,6 +238,38 @@ CAMLErrorCode AMLObject_AddData(amlObjectHandle_t amlObjHandle, const char* name
         return ExceptionCodeToErrorCode(e.code());
     }
 
+    ResetAmlDataIndex(amlObjHandle);
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObject_Freeze(amlObjectHandle_t amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    AMLObject* amlObj = FindAmlObj(amlObjHandle);
+    if (!amlObj)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    if (IsAmlObjFrozen(amlObjHandle))
+    {
+        return CAML_OK;
+    }
+
+    try
+    {
+        if (!FreezeAmlObj(amlObjHandle))
+        {
+            return CAML_NO_MEMORY;
+        }
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
     return CAML_OK;
 }
 
@@ -220,6 +334,51 @@ CAMLErrorCode AMLObject_GetDataNames(amlObjectHandle_t amlObjHandle, char*** nam
     return CAML_OK;
 }
 
+CAMLErrorCode AMLObject_GetDataCount(amlObjectHandle_t amlObjHandle, size_t* count)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(count);
+
+    const AmlDataIndex* index = GetAmlDataIndex(amlObjHandle);
+    if (!index)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    *count = index->names.size();
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObject_GetDataAt(amlObjectHandle_t amlObjHandle, size_t index, const char** name, amlDataHandle_t* amlDataHandle)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(name);
+    VERIFY_PARAM_NON_NULL(amlDataHandle);
+
+    const AmlDataIndex* dataIndex = GetAmlDataIndex(amlObjHandle);
+    if (!dataIndex)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    if (index >= dataIndex->names.size())
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    amlDataHandle_t handle = ResolveAmlDataHandle(dataIndex, index);
+    if (NULL == handle)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *name = dataIndex->names[index].c_str();
+    *amlDataHandle = handle;
+
+    return CAML_OK;
+}
+
 CAMLErrorCode AMLObject_GetDeviceId(amlObjectHandle_t amlObjHandle, char** deviceId)
 {
     VERIFY_PARAM_NON_NULL(amlObjHandle);
@@ -262,6 +421,25 @@ CAMLErrorCode AMLObject_GetTimeStamp(amlObjectHandle_t amlObjHandle, char** time
     return CAML_OK;
 }
 
+CAMLErrorCode AMLObject_GetEpoch(amlObjectHandle_t amlObjHandle, int64_t* epoch)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(epoch);
+
+    AMLObject* amlObj = FindAmlObj(amlObjHandle);
+    if (!amlObj)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    if (!ParseEpoch(amlObj->getTimeStamp(), epoch))
+    {
+        return CAML_WRONG_GETTER_TYPE;
+    }
+
+    return CAML_OK;
+}
+
 CAMLErrorCode AMLObject_GetId(amlObjectHandle_t amlObjHandle, char** id)
 {
     VERIFY_PARAM_NON_NULL(amlObjHandle);
@@ -282,3 +460,118 @@ CAMLErrorCode AMLObject_GetId(amlObjectHandle_t amlObjHandle, char** id)
 
     return CAML_OK;
 }
+
+CAMLErrorCode AMLObject_Diff(amlObjectHandle_t prev, amlObjectHandle_t curr, amlPatchHandle_t* patch)
+{
+    VERIFY_PARAM_NON_NULL(prev);
+    VERIFY_PARAM_NON_NULL(curr);
+    VERIFY_PARAM_NON_NULL(patch);
+
+    AMLObject* prevObj = FindAmlObj(prev);
+    AMLObject* currObj = FindAmlObj(curr);
+    if (!prevObj || !currObj)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AMLPatch* amlPatch = nullptr;
+    try
+    {
+        amlPatch = DiffAmlObject(*prevObj, *currObj);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    amlPatchHandle_t handle = AddAmlPatchHandle(amlPatch);
+    if (!handle)
+    {
+        delete amlPatch;
+        return CAML_NO_MEMORY;
+    }
+
+    *patch = handle;
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObject_ApplyPatch(amlObjectHandle_t base, amlPatchHandle_t patch, amlObjectHandle_t* result)
+{
+    VERIFY_PARAM_NON_NULL(base);
+    VERIFY_PARAM_NON_NULL(patch);
+    VERIFY_PARAM_NON_NULL(result);
+
+    AMLObject* baseObj = FindAmlObj(base);
+    AMLPatch* amlPatch = FindAmlPatch(patch);
+    if (!baseObj || !amlPatch)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AMLObject* resultObj = nullptr;
+    try
+    {
+        resultObj = ApplyAmlPatch(*baseObj, *amlPatch);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    amlObjectHandle_t handle = AddAmlObjHandle(resultObj, true);
+    if (!handle)
+    {
+        delete resultObj;
+        return CAML_NO_MEMORY;
+    }
+
+    *result = handle;
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLPatch(amlPatchHandle_t patch)
+{
+    VERIFY_PARAM_NON_NULL(patch);
+
+    AMLPatch* amlPatch = FindAmlPatch(patch);
+    if (!amlPatch)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    RemoveAmlPatch(patch);
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLPatch_GetChangeCount(amlPatchHandle_t patch, size_t* count)
+{
+    VERIFY_PARAM_NON_NULL(patch);
+    VERIFY_PARAM_NON_NULL(count);
+
+    AMLPatch* amlPatch = FindAmlPatch(patch);
+    if (!amlPatch)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    *count = amlPatch->ops.size();
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObject_GetEstimatedMemoryUsage(amlObjectHandle_t amlObjHandle, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(size);
+
+    AMLObject* amlObj = FindAmlObj(amlObjHandle);
+    if (!amlObj)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    *size = GetAmlObjHandleSize() + EstimateMemoryUsage(*amlObj);
+
+    return CAML_OK;
+}
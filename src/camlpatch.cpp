@@ -0,0 +1,599 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <memory>
+
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+#include "camlpatch.h"
+#include "camlutils.h"
+
+using namespace std;
+using namespace AML;
+
+#define PATCH_MAGIC_0   'A'
+#define PATCH_MAGIC_1   'P'
+#define PATCH_VERSION   1
+
+#define VALUE_TAG_STR       0
+#define VALUE_TAG_STRARR    1
+#define VALUE_TAG_DATA      2
+
+#define TIMESTAMP_TAG_STR   0
+#define TIMESTAMP_TAG_EPOCH 1
+
+// Nesting of AMLData in a patch, which bounds the recursion driven by the patch bytes.
+#define PATCH_MAX_DEPTH     64
+
+// Ops grouped by path, so that a patch can be applied in a single walk over the base object.
+typedef struct PatchNode
+{
+    const AMLPatchOp* op;
+    map<string, struct PatchNode> children;
+
+    PatchNode() : op(nullptr) {}
+} PatchNode;
+
+static AMLPatchOp MakeSetOp(const vector<string>& path, const AMLData& data, const string& key)
+{
+    AMLPatchOp op;
+    op.path = path;
+    op.path.push_back(key);
+
+    switch (data.getValueType(key))
+    {
+        case AMLValueType::String :
+            op.type = PATCH_OP_SET_STR;
+            op.str = data.getValueToStr(key);
+            break;
+        case AMLValueType::StringArray :
+            op.type = PATCH_OP_SET_STRARR;
+            op.strArr = data.getValueToStrArr(key);
+            break;
+        default : /* AMLValueType::AMLData */
+            op.type = PATCH_OP_SET_DATA;
+            op.data = data.getValueToAMLData(key);
+            break;
+    }
+
+    return op;
+}
+
+static void DiffAmlData(vector<string>& path, const AMLData& prev, const AMLData& curr, vector<AMLPatchOp>& ops)
+{
+    vector<string> prevKeys = prev.getKeys();
+    vector<string> currKeys = curr.getKeys();
+    sort(prevKeys.begin(), prevKeys.end());
+
+    for (const string& key : currKeys)
+    {
+        if (!binary_search(prevKeys.begin(), prevKeys.end(), key) ||
+            prev.getValueType(key) != curr.getValueType(key))
+        {
+            ops.push_back(MakeSetOp(path, curr, key));
+            continue;
+        }
+
+        switch (curr.getValueType(key))
+        {
+            case AMLValueType::String :
+                if (prev.getValueToStr(key) != curr.getValueToStr(key))
+                {
+                    ops.push_back(MakeSetOp(path, curr, key));
+                }
+                break;
+            case AMLValueType::StringArray :
+                if (prev.getValueToStrArr(key) != curr.getValueToStrArr(key))
+                {
+                    ops.push_back(MakeSetOp(path, curr, key));
+                }
+                break;
+            default : /* AMLValueType::AMLData */
+                path.push_back(key);
+                DiffAmlData(path, prev.getValueToAMLData(key), curr.getValueToAMLData(key), ops);
+                path.pop_back();
+                break;
+        }
+    }
+
+    sort(currKeys.begin(), currKeys.end());
+    for (const string& key : prevKeys)
+    {
+        if (!binary_search(currKeys.begin(), currKeys.end(), key))
+        {
+            AMLPatchOp op;
+            op.type = PATCH_OP_REMOVE;
+            op.path = path;
+            op.path.push_back(key);
+            ops.push_back(op);
+        }
+    }
+}
+
+AMLPatch* DiffAmlObject(const AMLObject& prev, const AMLObject& curr)
+{
+    unique_ptr<AMLPatch> patch(new AMLPatch());
+    patch->deviceId = curr.getDeviceId();
+    patch->timeStamp = curr.getTimeStamp();
+    patch->id = curr.getId();
+
+    vector<string> prevNames = prev.getDataNames();
+    vector<string> currNames = curr.getDataNames();
+    sort(prevNames.begin(), prevNames.end());
+    sort(currNames.begin(), currNames.end());
+
+    vector<string> path;
+    for (const string& name : currNames)
+    {
+        if (!binary_search(prevNames.begin(), prevNames.end(), name))
+        {
+            AMLPatchOp op;
+            op.type = PATCH_OP_SET_DATA;
+            op.path.push_back(name);
+            op.data = curr.getData(name);
+            patch->ops.push_back(op);
+            continue;
+        }
+
+        path.push_back(name);
+        DiffAmlData(path, prev.getData(name), curr.getData(name), patch->ops);
+        path.pop_back();
+    }
+
+    for (const string& name : prevNames)
+    {
+        if (!binary_search(currNames.begin(), currNames.end(), name))
+        {
+            AMLPatchOp op;
+            op.type = PATCH_OP_REMOVE;
+            op.path.push_back(name);
+            patch->ops.push_back(op);
+        }
+    }
+
+    return patch.release();
+}
+
+static void CopyValue(const AMLData& from, const string& key, AMLData& to)
+{
+    switch (from.getValueType(key))
+    {
+        case AMLValueType::String :
+            to.setValue(key, from.getValueToStr(key));
+            break;
+        case AMLValueType::StringArray :
+            to.setValue(key, from.getValueToStrArr(key));
+            break;
+        default : /* AMLValueType::AMLData */
+            to.setValue(key, from.getValueToAMLData(key));
+            break;
+    }
+}
+
+static AMLData ApplyToAmlData(const AMLData& base, const PatchNode& node)
+{
+    AMLData result;
+    vector<string> baseKeys = base.getKeys();
+    sort(baseKeys.begin(), baseKeys.end());
+
+    for (const string& key : baseKeys)
+    {
+        map<string, PatchNode>::const_iterator it = node.children.find(key);
+        if (it == node.children.end())
+        {
+            CopyValue(base, key, result);
+        }
+        else if (!it->second.op)
+        {
+            if (AMLValueType::AMLData != base.getValueType(key))
+            {
+                throw AMLException(INVALID_PARAM);
+            }
+            result.setValue(key, ApplyToAmlData(base.getValueToAMLData(key), it->second));
+        }
+    }
+
+    for (const auto& child : node.children)
+    {
+        const AMLPatchOp* op = child.second.op;
+        if (!op)
+        {
+            if (!binary_search(baseKeys.begin(), baseKeys.end(), child.first))
+            {
+                throw AMLException(INVALID_PARAM);
+            }
+            continue;
+        }
+
+        switch (op->type)
+        {
+            case PATCH_OP_REMOVE :
+                if (!binary_search(baseKeys.begin(), baseKeys.end(), child.first))
+                {
+                    throw AMLException(INVALID_PARAM);
+                }
+                break;
+            case PATCH_OP_SET_STR :
+                result.setValue(child.first, op->str);
+                break;
+            case PATCH_OP_SET_STRARR :
+                result.setValue(child.first, op->strArr);
+                break;
+            default : /* PATCH_OP_SET_DATA */
+                result.setValue(child.first, op->data);
+                break;
+        }
+    }
+
+    return result;
+}
+
+AMLObject* ApplyAmlPatch(const AMLObject& base, const AMLPatch& patch)
+{
+    if (base.getDeviceId() != patch.deviceId)
+    {
+        throw AMLException(INVALID_PARAM);
+    }
+
+    PatchNode root;
+    for (const AMLPatchOp& op : patch.ops)
+    {
+        PatchNode* node = &root;
+        for (const string& key : op.path)
+        {
+            if (node->op)
+            {
+                throw AMLException(INVALID_PARAM);
+            }
+            node = &node->children[key];
+        }
+        if (node->op || !node->children.empty())
+        {
+            throw AMLException(INVALID_PARAM);
+        }
+        node->op = &op;
+    }
+
+    unique_ptr<AMLObject> result(new AMLObject(patch.deviceId, patch.timeStamp, patch.id));
+    vector<string> baseNames = base.getDataNames();
+    sort(baseNames.begin(), baseNames.end());
+
+    for (const string& name : baseNames)
+    {
+        map<string, PatchNode>::const_iterator it = root.children.find(name);
+        if (it == root.children.end())
+        {
+            result->addData(name, base.getData(name));
+        }
+        else if (!it->second.op)
+        {
+            result->addData(name, ApplyToAmlData(base.getData(name), it->second));
+        }
+    }
+
+    for (const auto& child : root.children)
+    {
+        const AMLPatchOp* op = child.second.op;
+        bool inBase = binary_search(baseNames.begin(), baseNames.end(), child.first);
+
+        if (!op)
+        {
+            if (!inBase)
+            {
+                throw AMLException(INVALID_PARAM);
+            }
+        }
+        else if (PATCH_OP_REMOVE == op->type)
+        {
+            if (!inBase)
+            {
+                throw AMLException(INVALID_PARAM);
+            }
+        }
+        else if (PATCH_OP_SET_DATA == op->type)
+        {
+            result->addData(child.first, op->data);
+        }
+        else
+        {
+            // AMLObject only holds AMLData values.
+            throw AMLException(INVALID_PARAM);
+        }
+    }
+
+    return result.release();
+}
+
+static void AppendString(string& out, const string& str)
+{
+    AppendVarint(out, str.size());
+    out.append(str);
+}
+
+static void AppendStringArray(string& out, const vector<string>& strArr)
+{
+    AppendVarint(out, strArr.size());
+    for (const string& str : strArr)
+    {
+        AppendString(out, str);
+    }
+}
+
+static void AppendTimeStamp(string& out, const string& timeStamp)
+{
+    int64_t epoch;
+    if (ParseEpoch(timeStamp, &epoch))
+    {
+        out.push_back(TIMESTAMP_TAG_EPOCH);
+        AppendVarint(out, (uint64_t)epoch);
+    }
+    else
+    {
+        out.push_back(TIMESTAMP_TAG_STR);
+        AppendString(out, timeStamp);
+    }
+}
+
+static void AppendAmlData(string& out, const AMLData& data)
+{
+    vector<string> keys = data.getKeys();
+    AppendVarint(out, keys.size());
+
+    for (const string& key : keys)
+    {
+        AppendString(out, key);
+        switch (data.getValueType(key))
+        {
+            case AMLValueType::String :
+                out.push_back(VALUE_TAG_STR);
+                AppendString(out, data.getValueToStr(key));
+                break;
+            case AMLValueType::StringArray :
+                out.push_back(VALUE_TAG_STRARR);
+                AppendStringArray(out, data.getValueToStrArr(key));
+                break;
+            default : /* AMLValueType::AMLData */
+                out.push_back(VALUE_TAG_DATA);
+                AppendAmlData(out, data.getValueToAMLData(key));
+                break;
+        }
+    }
+}
+
+string PatchToByte(const string& repId, const AMLPatch& patch)
+{
+    string out;
+    out.push_back(PATCH_MAGIC_0);
+    out.push_back(PATCH_MAGIC_1);
+    out.push_back(PATCH_VERSION);
+
+    AppendString(out, repId);
+    AppendString(out, patch.deviceId);
+    AppendTimeStamp(out, patch.timeStamp);
+    AppendString(out, patch.id);
+
+    AppendVarint(out, patch.ops.size());
+    for (const AMLPatchOp& op : patch.ops)
+    {
+        out.push_back((char)op.type);
+        AppendStringArray(out, op.path);
+
+        switch (op.type)
+        {
+            case PATCH_OP_SET_STR :
+                AppendString(out, op.str);
+                break;
+            case PATCH_OP_SET_STRARR :
+                AppendStringArray(out, op.strArr);
+                break;
+            case PATCH_OP_SET_DATA :
+                AppendAmlData(out, op.data);
+                break;
+            default : /* PATCH_OP_REMOVE */
+                break;
+        }
+    }
+
+    return out;
+}
+
+// Every reader throws AMLException(INVALID_BYTE_STR) on truncated or malformed input.
+class PatchReader
+{
+public:
+    PatchReader(const uint8_t* byte, size_t size) : m_pos(byte), m_end(byte + size) {}
+
+    bool atEnd() const
+    {
+        return m_pos == m_end;
+    }
+
+    uint8_t readByte()
+    {
+        if (m_pos >= m_end)
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+        return *m_pos++;
+    }
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        if (!ReadVarint(&m_pos, m_end, &value))
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+        return value;
+    }
+
+    string readString()
+    {
+        uint64_t size = readVarint();
+        if (size > (uint64_t)(m_end - m_pos))
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+        string str((const char*)m_pos, (size_t)size);
+        m_pos += size;
+        return str;
+    }
+
+    vector<string> readStringArray()
+    {
+        uint64_t count = readVarint();
+        if (count > (uint64_t)(m_end - m_pos))
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+
+        vector<string> strArr;
+        strArr.reserve((size_t)count);
+        for (uint64_t i = 0; i < count; i++)
+        {
+            strArr.push_back(readString());
+        }
+        return strArr;
+    }
+
+    string readTimeStamp()
+    {
+        switch (readByte())
+        {
+            case TIMESTAMP_TAG_STR :
+                return readString();
+            case TIMESTAMP_TAG_EPOCH :
+            {
+                uint64_t epoch = readVarint();
+                if (epoch > (uint64_t)INT64_MAX)
+                {
+                    throw AMLException(INVALID_BYTE_STR);
+                }
+                return FormatEpoch((int64_t)epoch);
+            }
+            default :
+                throw AMLException(INVALID_BYTE_STR);
+        }
+    }
+
+    AMLData readAmlData(size_t depth = 0)
+    {
+        if (depth >= PATCH_MAX_DEPTH)
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+
+        AMLData data;
+        uint64_t count = readVarint();
+
+        for (uint64_t i = 0; i < count; i++)
+        {
+            string key = readString();
+            try
+            {
+                switch (readByte())
+                {
+                    case VALUE_TAG_STR :
+                        data.setValue(key, readString());
+                        break;
+                    case VALUE_TAG_STRARR :
+                        data.setValue(key, readStringArray());
+                        break;
+                    case VALUE_TAG_DATA :
+                        data.setValue(key, readAmlData(depth + 1));
+                        break;
+                    default :
+                        throw AMLException(INVALID_BYTE_STR);
+                }
+            }
+            catch (const AMLException& e)
+            {
+                // e.g. a duplicated key
+                throw AMLException(INVALID_BYTE_STR);
+            }
+        }
+        return data;
+    }
+
+private:
+    const uint8_t* m_pos;
+    const uint8_t* m_end;
+};
+
+AMLPatch* ByteToPatch(const string& repId, const uint8_t* byte, size_t size)
+{
+    PatchReader reader(byte, size);
+
+    if (PATCH_MAGIC_0 != reader.readByte() ||
+        PATCH_MAGIC_1 != reader.readByte() ||
+        PATCH_VERSION != reader.readByte())
+    {
+        throw AMLException(INVALID_BYTE_STR);
+    }
+
+    if (repId != reader.readString())
+    {
+        throw AMLException(NOT_MATCH_TO_AML_MODEL);
+    }
+
+    unique_ptr<AMLPatch> patch(new AMLPatch());
+    patch->deviceId = reader.readString();
+    patch->timeStamp = reader.readTimeStamp();
+    patch->id = reader.readString();
+
+    uint64_t count = reader.readVarint();
+    for (uint64_t i = 0; i < count; i++)
+    {
+        AMLPatchOp op;
+        op.type = (AMLPatchOpType)reader.readByte();
+        op.path = reader.readStringArray();
+        if (op.path.empty() || op.path.size() > PATCH_MAX_DEPTH)
+        {
+            throw AMLException(INVALID_BYTE_STR);
+        }
+
+        switch (op.type)
+        {
+            case PATCH_OP_REMOVE :
+                break;
+            case PATCH_OP_SET_STR :
+                op.str = reader.readString();
+                break;
+            case PATCH_OP_SET_STRARR :
+                op.strArr = reader.readStringArray();
+                break;
+            case PATCH_OP_SET_DATA :
+                op.data = reader.readAmlData();
+                break;
+            default :
+                throw AMLException(INVALID_BYTE_STR);
+        }
+        patch->ops.push_back(op);
+    }
+
+    if (!reader.atEnd())
+    {
+        throw AMLException(INVALID_BYTE_STR);
+    }
+
+    return patch.release();
+}
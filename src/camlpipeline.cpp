@@ -0,0 +1,430 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+#include "camlrepresentation.h"
+#include "camlinterface.h"
+#include "camlerrorcodes.h"
+#include "camlhandlemanager.h"
+#include "camlutils.h"
+#include "camlqueue.h"
+
+using namespace std;
+using namespace AML;
+
+typedef struct
+{
+    string deviceId;
+    void* record;               // until the build stage
+    amlObjectHandle_t amlObj;   // from the build stage to the serialize stage
+    string data;                // from the serialize stage
+} PipelineItem;
+
+/**
+ * Queue of one thread of a stage.
+ * Items move without locks. The mutex is taken only to sleep on an empty or full queue and to wake the sleeper.
+ */
+class PipelinePartition
+{
+public:
+    explicit PipelinePartition(size_t capacity)
+        : queue(capacity), depth(0), emptyWaiters(0), fullWaiters(0)
+    {
+    }
+
+    BoundedQueue<PipelineItem*> queue;
+    atomic<size_t> depth;
+    atomic<size_t> emptyWaiters;
+    atomic<size_t> fullWaiters;
+    mutex mtx;
+    condition_variable notEmpty;
+    condition_variable notFull;
+};
+
+typedef struct
+{
+    vector<unique_ptr<PipelinePartition> > partitions;
+    vector<thread> workers;
+    atomic<bool> closing;       // no more items come from the previous stage
+    atomic<uint64_t> processed;
+    atomic<uint64_t> rejected;
+    atomic<uint64_t> dropped;
+} PipelineStage;
+
+class AmlPipeline
+{
+public:
+    AmlPipeline(const shared_ptr<AmlModel>& model, const CAMLPipelineConfig& config)
+        : m_model(model), m_config(config), m_start(chrono::steady_clock::now())
+    {
+        for (size_t s = 0; s < CAML_PIPELINE_STAGES; s++)
+        {
+            size_t workers = (0 == config.workers[s]) ? 1 : config.workers[s];
+            for (size_t i = 0; i < workers; i++)
+            {
+                m_stages[s].partitions.push_back(unique_ptr<PipelinePartition>(new PipelinePartition(config.queueCapacity)));
+            }
+            m_stages[s].closing = false;
+            m_stages[s].processed = 0;
+            m_stages[s].rejected = 0;
+            m_stages[s].dropped = 0;
+        }
+    }
+
+    ~AmlPipeline()
+    {
+        stop();
+    }
+
+    // Throws std::system_error if a thread fails to start.
+    void start()
+    {
+        for (size_t s = 0; s < CAML_PIPELINE_STAGES; s++)
+        {
+            for (size_t i = 0; i < m_stages[s].partitions.size(); i++)
+            {
+                m_stages[s].workers.push_back(thread(&AmlPipeline::work, this, s, i));
+            }
+        }
+    }
+
+    // Stages are closed from the first one, so that each of them drains what the previous one has passed.
+    void stop()
+    {
+        for (size_t s = 0; s < CAML_PIPELINE_STAGES; s++)
+        {
+            PipelineStage& stage = m_stages[s];
+            stage.closing = true;
+            for (unique_ptr<PipelinePartition>& partition : stage.partitions)
+            {
+                lock_guard<mutex> lock(partition->mtx);
+                partition->notEmpty.notify_all();
+            }
+            for (thread& worker : stage.workers)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+        }
+    }
+
+    void push(const char* deviceId, void* record)
+    {
+        PipelineItem* item = new PipelineItem;
+        item->deviceId = deviceId;
+        item->record = record;
+        item->amlObj = NULL;
+
+        enqueue(CAML_STAGE_BUILD, item);
+    }
+
+    void getMetrics(CAMLPipelineStage stage, CAMLPipelineStageMetrics& metrics) const
+    {
+        const PipelineStage& pipelineStage = m_stages[stage];
+        metrics.processed = pipelineStage.processed;
+        metrics.rejected = pipelineStage.rejected;
+        metrics.dropped = pipelineStage.dropped;
+        metrics.queueDepth = 0;
+        metrics.queueCapacity = 0;
+        for (const unique_ptr<PipelinePartition>& partition : pipelineStage.partitions)
+        {
+            metrics.queueDepth += partition->depth;
+            metrics.queueCapacity += partition->queue.capacity();
+        }
+
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - m_start;
+        metrics.throughput = (elapsed.count() > 0) ? metrics.processed / elapsed.count() : 0;
+    }
+
+private:
+    void enqueue(size_t stage, PipelineItem* item)
+    {
+        PipelineStage& pipelineStage = m_stages[stage];
+        size_t index = HashFnv1a(item->deviceId.data(), item->deviceId.size()) % pipelineStage.partitions.size();
+        PipelinePartition& partition = *pipelineStage.partitions[index];
+
+        // The depth counts an item before it is visible, so that it never falls below the items in the queue.
+        for (;;)
+        {
+            partition.depth++;
+            if (partition.queue.push(item))
+            {
+                break;
+            }
+            partition.depth--;
+
+            if (CAML_BACKPRESSURE_DROP_OLDEST == m_config.backpressure)
+            {
+                PipelineItem* oldest = NULL;
+                if (partition.queue.pop(oldest))
+                {
+                    partition.depth--;
+                    pipelineStage.dropped++;
+                    discard(stage, oldest);
+                }
+                continue;
+            }
+
+            unique_lock<mutex> lock(partition.mtx);
+            partition.fullWaiters++;
+            partition.notFull.wait(lock, [&partition]()
+            {
+                return partition.depth < partition.queue.capacity();
+            });
+            partition.fullWaiters--;
+        }
+
+        // A sleeper counts itself before it checks the depth, so either it sees the item or it is woken here.
+        if (0 < partition.emptyWaiters)
+        {
+            lock_guard<mutex> lock(partition.mtx);
+            partition.notEmpty.notify_one();
+        }
+    }
+
+    // Returns false when the stage is closed and the queue is empty.
+    bool dequeue(PipelineStage& stage, PipelinePartition& partition, PipelineItem*& item)
+    {
+        for (;;)
+        {
+            if (partition.queue.pop(item))
+            {
+                partition.depth--;
+                if (0 < partition.fullWaiters)
+                {
+                    lock_guard<mutex> lock(partition.mtx);
+                    partition.notFull.notify_all();
+                }
+                return true;
+            }
+
+            unique_lock<mutex> lock(partition.mtx);
+            partition.emptyWaiters++;
+            partition.notEmpty.wait(lock, [&stage, &partition]()
+            {
+                return 0 < partition.depth || stage.closing;
+            });
+            partition.emptyWaiters--;
+
+            if (0 == partition.depth && stage.closing)
+            {
+                return false;
+            }
+        }
+    }
+
+    void work(size_t stage, size_t index)
+    {
+        PipelineStage& pipelineStage = m_stages[stage];
+        PipelinePartition& partition = *pipelineStage.partitions[index];
+
+        PipelineItem* item = NULL;
+        while (dequeue(pipelineStage, partition, item))
+        {
+            if (!process(stage, *item))
+            {
+                pipelineStage.rejected++;
+                release(item);
+                continue;
+            }
+
+            pipelineStage.processed++;
+            if (CAML_STAGE_SINK == stage)
+            {
+                release(item);
+            }
+            else
+            {
+                enqueue(stage + 1, item);
+            }
+        }
+    }
+
+    // Returns false if the item is rejected.
+    bool process(size_t stage, PipelineItem& item)
+    {
+        switch (stage)
+        {
+            case CAML_STAGE_BUILD :
+            {
+                // The record is given to the callback, which owns it from now on.
+                void* record = item.record;
+                item.record = NULL;
+                return 0 == m_config.build(record, &item.amlObj, m_config.userData) && NULL != item.amlObj;
+            }
+            case CAML_STAGE_VALIDATE :
+                return !m_config.validate || 0 == m_config.validate(item.amlObj, m_config.userData);
+            case CAML_STAGE_SERIALIZE :
+                return serialize(item);
+            default : /* CAML_STAGE_SINK */
+                return 0 == m_config.sink(item.deviceId.c_str(), (const uint8_t*)item.data.data(), item.data.size(),
+                                          m_config.userData);
+        }
+    }
+
+    bool serialize(PipelineItem& item)
+    {
+        AMLObject* amlObj = FindAmlObj(item.amlObj);
+        if (!amlObj)
+        {
+            return false;
+        }
+
+        try
+        {
+            item.data = (CAML_FORMAT_AML == m_config.format) ? ConvertDataToAml(*m_model, *amlObj) :
+                        AcquireRepresentation(*m_model, *amlObj)->DataToByte(*amlObj);
+        }
+        catch (const AMLException&)
+        {
+            return false;
+        }
+        catch (const bad_alloc&)
+        {
+            return false;
+        }
+
+        DestroyAMLObject(item.amlObj);
+        item.amlObj = NULL;
+        return true;
+    }
+
+    // Frees an item which is dropped from the queue of 'stage'.
+    void discard(size_t stage, PipelineItem* item)
+    {
+        if (CAML_STAGE_BUILD == stage && m_config.discard)
+        {
+            m_config.discard(item->record, m_config.userData);
+        }
+        release(item);
+    }
+
+    void release(PipelineItem* item)
+    {
+        if (item->amlObj)
+        {
+            DestroyAMLObject(item->amlObj);
+        }
+        delete item;
+    }
+
+    shared_ptr<AmlModel> m_model;
+    CAMLPipelineConfig m_config;
+    chrono::steady_clock::time_point m_start;
+    PipelineStage m_stages[CAML_PIPELINE_STAGES];
+};
+
+CAMLErrorCode CreateAMLPipeline(const representation_t repHandle, const CAMLPipelineConfig* config,
+                                amlPipeline_t* pipeline)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(config);
+    VERIFY_PARAM_NON_NULL(config->build);
+    VERIFY_PARAM_NON_NULL(config->sink);
+    VERIFY_PARAM_NON_NULL(config->queueCapacity);
+    VERIFY_PARAM_NON_NULL(pipeline);
+    if ((CAML_FORMAT_AML != config->format && CAML_FORMAT_BYTE != config->format) ||
+        (CAML_BACKPRESSURE_BLOCK != config->backpressure && CAML_BACKPRESSURE_DROP_OLDEST != config->backpressure) ||
+        config->queueCapacity > BoundedQueue<PipelineItem*>::maxCapacity())
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AmlPipeline* amlPipeline = NULL;
+    try
+    {
+        amlPipeline = new AmlPipeline(model, *config);
+        amlPipeline->start();
+    }
+    catch (const bad_alloc&)
+    {
+        delete amlPipeline;
+        return CAML_NO_MEMORY;
+    }
+    catch (const system_error&)
+    {
+        delete amlPipeline;
+        return CAML_NO_MEMORY;
+    }
+
+    *pipeline = amlPipeline;
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLPipeline(amlPipeline_t pipeline)
+{
+    VERIFY_PARAM_NON_NULL(pipeline);
+
+    delete (AmlPipeline*)pipeline;
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLPipeline_Push(amlPipeline_t pipeline, const char* deviceId, void* record)
+{
+    VERIFY_PARAM_NON_NULL(pipeline);
+    VERIFY_PARAM_NON_NULL(deviceId);
+
+    try
+    {
+        ((AmlPipeline*)pipeline)->push(deviceId, record);
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLPipeline_GetMetrics(const amlPipeline_t pipeline, const CAMLPipelineStage stage,
+                                     CAMLPipelineStageMetrics* metrics)
+{
+    VERIFY_PARAM_NON_NULL(pipeline);
+    VERIFY_PARAM_NON_NULL(metrics);
+    if ((size_t)stage >= CAML_PIPELINE_STAGES)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    ((const AmlPipeline*)pipeline)->getMetrics(stage, *metrics);
+
+    return CAML_OK;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <new>
+
+#include "camlinterface.h"
+#include "camlerrorcodes.h"
+#include "camlqueue.h"
+
+using namespace std;
+
+typedef BoundedQueue<amlObjectHandle_t> AmlObjectQueue;
+
+CAMLErrorCode CreateAMLObjectQueue(const size_t capacity, amlObjectQueue_t* queue)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    if (0 == capacity || capacity > AmlObjectQueue::maxCapacity())
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    // Cells are allocated by the constructor, which throws unlike the nothrow new of the queue itself.
+    AmlObjectQueue* objQueue = NULL;
+    try
+    {
+        objQueue = new AmlObjectQueue(capacity);
+    }
+    catch (const bad_alloc&)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *queue = objQueue;
+    return CAML_OK;
+}
+
+CAMLErrorCode DestroyAMLObjectQueue(amlObjectQueue_t queue)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+
+    delete (AmlObjectQueue*)queue;
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObjectQueue_Push(amlObjectQueue_t queue, amlObjectHandle_t amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    if (!((AmlObjectQueue*)queue)->push(amlObjHandle))
+    {
+        return CAML_QUEUE_FULL;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode AMLObjectQueue_Pop(amlObjectQueue_t queue, amlObjectHandle_t* amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(queue);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    if (!((AmlObjectQueue*)queue)->pop(*amlObjHandle))
+    {
+        return CAML_QUEUE_EMPTY;
+    }
+
+    return CAML_OK;
+}
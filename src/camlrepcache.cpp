@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <map>
+#include <mutex>
+
+#include "camlrepcache.h"
+
+using namespace std;
+
+static map<string, weak_ptr<AmlModel>> g_repCache;
+static mutex g_repCacheMtx;
+
+shared_ptr<AmlModel> GetSharedAmlModel(const string& key, const function<AmlModel*(void)>& load,
+                                       const function<bool(const AmlModel&)>& matches)
+{
+    // Models are loaded under the lock, so that modules starting together parse a model only once.
+    lock_guard<mutex> lock(g_repCacheMtx);
+
+    map<string, weak_ptr<AmlModel>>::iterator it = g_repCache.find(key);
+    if (it != g_repCache.end())
+    {
+        shared_ptr<AmlModel> model = it->second.lock();
+        if (model)
+        {
+            if (!matches || matches(*model))
+            {
+                return model;
+            }
+            return shared_ptr<AmlModel>(load());
+        }
+    }
+
+    // Drop models that are not used anymore.
+    for (it = g_repCache.begin(); it != g_repCache.end();)
+    {
+        if (it->second.expired())
+        {
+            it = g_repCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    shared_ptr<AmlModel> model(load());
+    g_repCache[key] = model;
+
+    return model;
+}
@@ -15,8 +15,16 @@
  *
  *******************************************************************************/
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <new>
 #include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 #include "Representation.h"
 #include "AMLInterface.h"
@@ -26,30 +34,137 @@
 #include "camlinterface.h"
 #include "camlerrorcodes.h"
 #include "camlhandlemanager.h"
+#include "camlrepcache.h"
+#include "camlamlparser.h"
 #include "camlutils.h"
 
 using namespace std;
 using namespace AML;
 
-CAMLErrorCode CreateRepresentation(const char* filePath, representation_t* repHandle)
+/**
+ * Config information of a data model, built once and shared by the handles of the model.
+ */
+struct AmlConfigInfo
 {
-    VERIFY_PARAM_NON_NULL(filePath);
-    VERIFY_PARAM_NON_NULL(repHandle);
+    AMLObject* amlObj;              // owned by 'handle'
+    amlObjectHandle_t handle;       // frozen and pinned, so users can't change or destroy it
+    map<string, int64_t> cycles;    // "cycle" of each AMLData that has a valid one
+
+    AmlConfigInfo() : amlObj(nullptr), handle(nullptr) {}
+
+    ~AmlConfigInfo()
+    {
+        if (handle)
+        {
+            RemoveOwnedAmlDataHandles(amlObj);
+            RemoveAmlObj(handle);
+        }
+        else
+        {
+            delete amlObj;
+        }
+    }
+};
+
+static bool ParseCycle(const string& value, int64_t& cycle)
+{
+    if (value == "once")
+    {
+        cycle = CAML_CYCLE_ONCE;
+        return true;
+    }
+
+    if (value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != string::npos)
+    {
+        return false;
+    }
+
+    cycle = strtoll(value.c_str(), nullptr, 10);
+    return true;
+}
+
+// Throws AMLException on failure.
+static shared_ptr<AmlConfigInfo> GetAmlConfigInfo(AmlModel& model)
+{
+    lock_guard<mutex> lock(model.configMtx);
+    if (model.configInfo)
+    {
+        return model.configInfo;
+    }
+
+    shared_ptr<AmlConfigInfo> config = make_shared<AmlConfigInfo>();
+    config->amlObj = AcquireRepresentation(model)->getConfigInfo();
+
+    for (const string& name : config->amlObj->getDataNames())
+    {
+        const AMLData& amlData = config->amlObj->getData(name);
+        for (const string& key : amlData.getKeys())
+        {
+            int64_t cycle = 0;
+            if (key == "cycle" && AMLValueType::String == amlData.getValueType(key) &&
+                ParseCycle(amlData.getValueToStr(key), cycle))
+            {
+                config->cycles[name] = cycle;
+            }
+        }
+    }
+
+    amlObjectHandle_t handle = AddAmlObjHandle(config->amlObj, true);
+    if (!handle)
+    {
+        throw AMLException(NO_MEMORY);
+    }
+    config->handle = handle;
+
+    if (!FreezeAmlObj(handle))
+    {
+        throw AMLException(NO_MEMORY);
+    }
+    PinAmlObj(handle);
+
+    model.configInfo = config;
+    return config;
+}
+
+static CAMLErrorCode AddRepresentation(const function<AmlModel*(void)>& load, representation_t* repHandle)
+{
+    shared_ptr<AmlModel> model;
+    try
+    {
+        model.reset(load());
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
 
-    Representation* rep = nullptr;
+    representation_t handle = AddRepresentationHandle(model);
+    if (!handle)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *repHandle = handle;
+    return CAML_OK;
+}
+
+static CAMLErrorCode AddSharedRepresentation(const string& key, const function<AmlModel*(void)>& load,
+                                             const function<bool(const AmlModel&)>& matches,
+                                             representation_t* repHandle)
+{
+    shared_ptr<AmlModel> model;
     try
     {
-        rep = new Representation(filePath);
+        model = GetSharedAmlModel(key, load, matches);
     }
     catch (const AMLException& e)
     {
         return ExceptionCodeToErrorCode(e.code());
     }
 
-    representation_t handle = AddRepresentationHandle(rep);
+    representation_t handle = AddRepresentationHandle(model);
     if (!handle)
     {
-        delete rep;
         return CAML_NO_MEMORY;
     }
 
@@ -57,11 +172,146 @@ CAMLErrorCode CreateRepresentation(const char* filePath, representation_t* repHa
     return CAML_OK;
 }
 
+CAMLErrorCode CreateRepresentation(const char* filePath, representation_t* repHandle)
+{
+    VERIFY_PARAM_NON_NULL(filePath);
+    VERIFY_PARAM_NON_NULL(repHandle);
+
+    string path(filePath);
+    return AddRepresentation([&path]()
+    {
+        return LoadAmlModel(path);
+    }, repHandle);
+}
+
+CAMLErrorCode CreateRepresentationFromBuffer(const char* buffer, const size_t size, representation_t* repHandle)
+{
+    VERIFY_PARAM_NON_NULL(buffer);
+    VERIFY_PARAM_NON_NULL(repHandle);
+    if (0 == size)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    return AddRepresentation([buffer, size]()
+    {
+        return LoadAmlModelFromBuffer(buffer, size, false);
+    }, repHandle);
+}
+
+CAMLErrorCode CreateLazyRepresentation(const char* filePath, representation_t* repHandle)
+{
+    VERIFY_PARAM_NON_NULL(filePath);
+    VERIFY_PARAM_NON_NULL(repHandle);
+
+    string path(filePath);
+    return AddRepresentation([&path]()
+    {
+        return LoadLazyAmlModel(path);
+    }, repHandle);
+}
+
+CAMLErrorCode CreateSharedRepresentation(const char* filePath, representation_t* repHandle)
+{
+    VERIFY_PARAM_NON_NULL(filePath);
+    VERIFY_PARAM_NON_NULL(repHandle);
+
+    char* realPath = realpath(filePath, NULL);
+    if (NULL == realPath)
+    {
+        return CAML_INVALID_FILE_PATH;
+    }
+    string path(realPath);
+    free(realPath);
+
+    return AddSharedRepresentation("path:" + path, [&path]()
+    {
+        return LoadAmlModel(path);
+    }, nullptr, repHandle);
+}
+
+CAMLErrorCode CreateSharedRepresentationFromBuffer(const char* buffer, const size_t size, representation_t* repHandle)
+{
+    VERIFY_PARAM_NON_NULL(buffer);
+    VERIFY_PARAM_NON_NULL(repHandle);
+    if (0 == size)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    char key[64];
+    snprintf(key, sizeof(key), "content:%016llx:%llu",
+             (unsigned long long)HashFnv1a(buffer, size), (unsigned long long)size);
+
+    // The hash only finds the candidate, and the content decides whether it is the same model.
+    return AddSharedRepresentation(key, [buffer, size]()
+    {
+        return LoadAmlModelFromBuffer(buffer, size, true);
+    }, [buffer, size](const AmlModel& model)
+    {
+        return model.source.size() == size && 0 == memcmp(model.source.data(), buffer, size);
+    }, repHandle);
+}
+
+static CAMLErrorCode ReloadRepresentation(representation_t repHandle, const function<AmlModel*(bool)>& load)
+{
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    // The new model is built without any lock, so conversions go on with the current one meanwhile.
+    shared_ptr<AmlModel> newModel;
+    try
+    {
+        newModel.reset(load(nullptr != model->lazy));
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    if (!ReplaceAmlModel(repHandle, newModel))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_Reload(representation_t repHandle, const char* filePath)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(filePath);
+
+    string path(filePath);
+    return ReloadRepresentation(repHandle, [&path](bool lazy)
+    {
+        return lazy ? LoadLazyAmlModel(path) : LoadAmlModel(path);
+    });
+}
+
+CAMLErrorCode Representation_ReloadFromBuffer(representation_t repHandle, const char* buffer, const size_t size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(buffer);
+    if (0 == size)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    return ReloadRepresentation(repHandle, [buffer, size](bool)
+    {
+        return LoadAmlModelFromBuffer(buffer, size, false);
+    });
+}
+
 CAMLErrorCode DestroyRepresentation(representation_t repHandle)
 {
     VERIFY_PARAM_NON_NULL(repHandle);
 
-    Representation* rep = FindRepresentation(repHandle);
+    shared_ptr<Representation> rep = FindRepresentation(repHandle);
     if (!rep)
     {
         return CAML_INVALID_HANDLE;
@@ -77,7 +327,7 @@ CAMLErrorCode Representation_GetRepId(representation_t repHandle, char** repId)
     VERIFY_PARAM_NON_NULL(repHandle);
     VERIFY_PARAM_NON_NULL(repId);
 
-    Representation* rep = FindRepresentation(repHandle);
+    shared_ptr<Representation> rep = FindRepresentation(repHandle);
     if (!rep)
     {
         return CAML_INVALID_HANDLE;
@@ -93,13 +343,28 @@ CAMLErrorCode Representation_GetRepId(representation_t repHandle, char** repId)
     return CAML_OK;
 }
 
+CAMLErrorCode Representation_GetLoadedClassCount(representation_t repHandle, size_t* loaded, size_t* total)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(loaded);
+    VERIFY_PARAM_NON_NULL(total);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model || !GetLoadedClassCount(*model, loaded, total))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    return CAML_OK;
+}
+
 CAMLErrorCode Representation_GetConfigInfo(representation_t repHandle, amlObjectHandle_t* amlObjHandle)
 {
     VERIFY_PARAM_NON_NULL(repHandle);
     VERIFY_PARAM_NON_NULL(amlObjHandle);
 
-    Representation* rep = FindRepresentation(repHandle);
-    if (!rep)
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
     {
         return CAML_INVALID_HANDLE;
     }
@@ -107,7 +372,7 @@ CAMLErrorCode Representation_GetConfigInfo(representation_t repHandle, amlObject
     AMLObject* amlObj = nullptr;
     try
     {
-        amlObj = rep->getConfigInfo();
+        amlObj = new AMLObject(*GetAmlConfigInfo(*model)->amlObj);
     }
     catch (const AMLException& e)
     {
@@ -125,15 +390,70 @@ CAMLErrorCode Representation_GetConfigInfo(representation_t repHandle, amlObject
     return CAML_OK;
 }
 
+CAMLErrorCode Representation_GetSharedConfigInfo(representation_t repHandle, amlObjectHandle_t* amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    try
+    {
+        *amlObjHandle = GetAmlConfigInfo(*model)->handle;
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_GetCycle(representation_t repHandle, const char* name, int64_t* cycle)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(name);
+    VERIFY_PARAM_NON_NULL(cycle);
+
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    shared_ptr<AmlConfigInfo> config;
+    try
+    {
+        config = GetAmlConfigInfo(*model);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    map<string, int64_t>::const_iterator it = config->cycles.find(name);
+    if (it == config->cycles.end())
+    {
+        return CAML_KEY_NOT_EXIST;
+    }
+
+    *cycle = it->second;
+    return CAML_OK;
+}
+
 CAMLErrorCode Representation_DataToAml(const representation_t repHandle, const amlObjectHandle_t amlObjHandle, char** amlStr)
 {
     VERIFY_PARAM_NON_NULL(repHandle);
     VERIFY_PARAM_NON_NULL(amlObjHandle);
     VERIFY_PARAM_NON_NULL(amlStr);
 
-    Representation* rep = FindRepresentation(repHandle);
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
     AMLObject* amlObj = FindAmlObj(amlObjHandle);
-    if (!rep || !amlObj)
+    if (!model || !amlObj)
     {
         return CAML_INVALID_HANDLE;
     }
@@ -141,7 +461,7 @@ CAMLErrorCode Representation_DataToAml(const representation_t repHandle, const a
     char* amlChar = NULL;
     try
     {
-        string amlString = rep->DataToAml(*amlObj);
+        string amlString = ConvertDataToAml(*model, *amlObj);
         amlChar = ConvertStringToCharStr(amlString);
         if (NULL == amlChar)
         {
@@ -158,24 +478,254 @@ CAMLErrorCode Representation_DataToAml(const representation_t repHandle, const a
     return CAML_OK;
 }
 
+// Throws AMLException on failure.
+static string SerializeAmlObject(AmlModel& model, const AMLObject& amlObj, CAMLSerialFormat format)
+{
+    if (CAML_FORMAT_AML == format)
+    {
+        return ConvertDataToAml(model, amlObj);
+    }
+    return AcquireRepresentation(model, amlObj)->DataToByte(amlObj);
+}
+
+static CAMLErrorCode SerializeToBuffer(representation_t repHandle, amlObjectHandle_t amlObjHandle,
+                                       CAMLSerialFormat format, void* buffer, size_t bufferSize, size_t* size)
+{
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    AMLObject* amlObj = FindAmlObj(amlObjHandle);
+    if (!model || !amlObj)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    string serialized;
+    try
+    {
+        serialized = SerializeAmlObject(*model, *amlObj, format);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    // AML(XML) string is written with its terminating null character.
+    size_t required = serialized.size() + (CAML_FORMAT_AML == format ? 1 : 0);
+    *size = required;
+    if (bufferSize < required)
+    {
+        return CAML_BUFFER_TOO_SMALL;
+    }
+
+    if (required > 0)
+    {
+        memcpy(buffer, serialized.c_str(), required);
+    }
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_DataToAmlBuffer(const representation_t repHandle, const amlObjectHandle_t amlObjHandle,
+                                             char* buffer, size_t bufferSize, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(size);
+    if (!buffer && bufferSize > 0)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    return SerializeToBuffer(repHandle, amlObjHandle, CAML_FORMAT_AML, buffer, bufferSize, size);
+}
+
+CAMLErrorCode Representation_DataToByteBuffer(const representation_t repHandle, const amlObjectHandle_t amlObjHandle,
+                                              uint8_t* buffer, size_t bufferSize, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(size);
+    if (!buffer && bufferSize > 0)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    return SerializeToBuffer(repHandle, amlObjHandle, CAML_FORMAT_BYTE, buffer, bufferSize, size);
+}
+
+CAMLErrorCode Representation_GetSerializedSize(const representation_t repHandle, const amlObjectHandle_t amlObjHandle,
+                                               CAMLSerialFormat format, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+    VERIFY_PARAM_NON_NULL(size);
+    if (CAML_FORMAT_AML != format && CAML_FORMAT_BYTE != format)
+    {
+        return CAML_INVALID_PARAM;
+    }
+
+    CAMLErrorCode result = SerializeToBuffer(repHandle, amlObjHandle, format, nullptr, 0, size);
+    return CAML_BUFFER_TOO_SMALL == result ? CAML_OK : result;
+}
+
+// Throws AMLException on failure.
+static AMLObject* AmlToAmlObject(AmlModel& model, const char* amlStr)
+{
+    ScratchBuffer amlString(amlStr, strlen(amlStr));
+    return ConvertAmlToData(model, amlString.str());
+}
+
+// Throws AMLException on failure.
+static AMLObject* ByteToAmlObject(AmlModel& model, const uint8_t* byte, size_t size)
+{
+    // Representation only decodes std::string, so the input is copied to a buffer reused by the thread.
+    ScratchBuffer byteString((const char*)byte, size);
+
+    // Binary data does not tell its SystemUnitClasses before it is decoded.
+    return AcquireFullRepresentation(model)->ByteToData(byteString.str());
+}
+
 CAMLErrorCode Representation_AmlToData(const representation_t repHandle, const char* amlStr, amlObjectHandle_t* amlObjHandle)
 {
     VERIFY_PARAM_NON_NULL(repHandle);
     VERIFY_PARAM_NON_NULL(amlStr);
     VERIFY_PARAM_NON_NULL(amlObjHandle);
 
-    Representation* rep = FindRepresentation(repHandle);
-    if (!rep)
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
     {
         return CAML_INVALID_HANDLE;
     }
 
     AMLObject* amlObj = nullptr;
-    string amlString(amlStr, strlen(amlStr));
+    try
+    {
+        amlObj = AmlToAmlObject(*model, amlStr);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    amlObjectHandle_t amlObjHandleNew = AddAmlObjHandle(amlObj, true);
+    if (!amlObjHandleNew)
+    {
+        delete amlObj;
+        return CAML_NO_MEMORY;
+    }
+
+    *amlObjHandle = amlObjHandleNew;
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_AmlParseEvents(const representation_t repHandle, const char* amlStr, size_t size,
+                                            CAMLParseCallback callback, void* userData)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(amlStr);
+    VERIFY_PARAM_NON_NULL(callback);
+
+    if (!FindAmlModel(repHandle))
+    {
+        return CAML_INVALID_HANDLE;
+    }
 
     try
     {
-        amlObj = rep->AmlToData(amlString);
+        ParseAmlEvents(amlStr, size, [callback, userData](const CAMLParseEvent& event)
+        {
+            return 0 == callback(&event, userData);
+        });
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    return CAML_OK;
+}
+
+/**
+ * Incremental parser of a handle, with the first error of the AML document being fed.
+ */
+typedef struct
+{
+    unique_ptr<AmlPushParser> parser;
+    CAMLErrorCode error;
+} AmlParser;
+
+CAMLErrorCode Representation_AmlParserCreate(const representation_t repHandle, amlParserHandle_t* parser)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(parser);
+
+    if (!FindAmlModel(repHandle))
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AmlParser* amlParser = new(std::nothrow) AmlParser();
+    if (NULL == amlParser)
+    {
+        return CAML_NO_MEMORY;
+    }
+    amlParser->parser.reset(new(std::nothrow) AmlPushParser());
+    amlParser->error = CAML_OK;
+    if (!amlParser->parser)
+    {
+        delete amlParser;
+        return CAML_NO_MEMORY;
+    }
+
+    *parser = amlParser;
+    return CAML_OK;
+}
+
+CAMLErrorCode AmlParser_Feed(amlParserHandle_t parser, const char* chunk, size_t size)
+{
+    VERIFY_PARAM_NON_NULL(parser);
+    VERIFY_PARAM_NON_NULL(chunk);
+
+    AmlParser* amlParser = (AmlParser*)parser;
+    if (CAML_OK != amlParser->error)
+    {
+        return amlParser->error;
+    }
+
+    try
+    {
+        amlParser->parser->feed(chunk, size);
+    }
+    catch (const AMLException& e)
+    {
+        amlParser->error = ExceptionCodeToErrorCode(e.code());
+    }
+
+    return amlParser->error;
+}
+
+CAMLErrorCode AmlParser_Finish(amlParserHandle_t parser, amlObjectHandle_t* amlObjHandle)
+{
+    VERIFY_PARAM_NON_NULL(parser);
+    VERIFY_PARAM_NON_NULL(amlObjHandle);
+
+    AmlParser* amlParser = (AmlParser*)parser;
+    unique_ptr<AmlPushParser> pushParser(new(std::nothrow) AmlPushParser());
+    if (!pushParser)
+    {
+        return CAML_NO_MEMORY;
+    }
+    pushParser.swap(amlParser->parser);
+
+    CAMLErrorCode error = amlParser->error;
+    amlParser->error = CAML_OK;
+    if (CAML_OK != error)
+    {
+        return error;
+    }
+
+    AMLObject* amlObj = nullptr;
+    try
+    {
+        amlObj = pushParser->finish();
     }
     catch (const AMLException& e)
     {
@@ -193,6 +743,15 @@ CAMLErrorCode Representation_AmlToData(const representation_t repHandle, const c
     return CAML_OK;
 }
 
+CAMLErrorCode DestroyAmlParser(amlParserHandle_t parser)
+{
+    VERIFY_PARAM_NON_NULL(parser);
+
+    delete (AmlParser*)parser;
+
+    return CAML_OK;
+}
+
 CAMLErrorCode Representation_DataToByte(const representation_t repHandle, const amlObjectHandle_t amlObjHandle, uint8_t** byte, size_t* size)
 {
     VERIFY_PARAM_NON_NULL(repHandle);
@@ -200,16 +759,16 @@ CAMLErrorCode Representation_DataToByte(const representation_t repHandle, const
     VERIFY_PARAM_NON_NULL(byte);
     VERIFY_PARAM_NON_NULL(size);
 
-    Representation* rep = FindRepresentation(repHandle);
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
     AMLObject* amlObj = FindAmlObj(amlObjHandle);
-    if (!rep || !amlObj)
+    if (!model || !amlObj)
     {
         return CAML_INVALID_HANDLE;
     }
 
     try
     {
-        string amlString = rep->DataToByte(*amlObj);
+        string amlString = AcquireRepresentation(*model, *amlObj)->DataToByte(*amlObj);
         char* temp = ConvertStringToCharStr(amlString);
         if (nullptr == temp)
         {
@@ -233,18 +792,16 @@ CAMLErrorCode Representation_ByteToData(const representation_t repHandle, const
     VERIFY_PARAM_NON_NULL(size);
     VERIFY_PARAM_NON_NULL(amlObjHandle);
 
-    Representation* rep = FindRepresentation(repHandle);
-    if (!rep)
+    shared_ptr<AmlModel> model = FindAmlModel(repHandle);
+    if (!model)
     {
         return CAML_INVALID_HANDLE;
     }
 
     AMLObject* amlObj = nullptr;
-    string byteString((char*)byte, size);
-
     try
     {
-        amlObj = rep->ByteToData(byteString);
+        amlObj = ByteToAmlObject(*model, byte, size);
     }
     catch (const AMLException& e)
     {
@@ -262,3 +819,64 @@ CAMLErrorCode Representation_ByteToData(const representation_t repHandle, const
 
     return CAML_OK;
 }
+
+CAMLErrorCode Representation_PatchToByte(const representation_t repHandle, const amlPatchHandle_t patch, uint8_t** byte, size_t* size)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(patch);
+    VERIFY_PARAM_NON_NULL(byte);
+    VERIFY_PARAM_NON_NULL(size);
+
+    shared_ptr<Representation> rep = FindRepresentation(repHandle);
+    AMLPatch* amlPatch = FindAmlPatch(patch);
+    if (!rep || !amlPatch)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    string patchString = PatchToByte(rep->getRepresentationId(), *amlPatch);
+    char* temp = ConvertStringToCharStr(patchString);
+    if (nullptr == temp)
+    {
+        return CAML_NO_MEMORY;
+    }
+
+    *byte = reinterpret_cast<uint8_t*>(temp);
+    *size = patchString.size();
+
+    return CAML_OK;
+}
+
+CAMLErrorCode Representation_ByteToPatch(const representation_t repHandle, const uint8_t* byte, const size_t size, amlPatchHandle_t* patch)
+{
+    VERIFY_PARAM_NON_NULL(repHandle);
+    VERIFY_PARAM_NON_NULL(byte);
+    VERIFY_PARAM_NON_NULL(size);
+    VERIFY_PARAM_NON_NULL(patch);
+
+    shared_ptr<Representation> rep = FindRepresentation(repHandle);
+    if (!rep)
+    {
+        return CAML_INVALID_HANDLE;
+    }
+
+    AMLPatch* amlPatch = nullptr;
+    try
+    {
+        amlPatch = ByteToPatch(rep->getRepresentationId(), byte, size);
+    }
+    catch (const AMLException& e)
+    {
+        return ExceptionCodeToErrorCode(e.code());
+    }
+
+    amlPatchHandle_t handle = AddAmlPatchHandle(amlPatch);
+    if (!handle)
+    {
+        delete amlPatch;
+        return CAML_NO_MEMORY;
+    }
+
+    *patch = handle;
+    return CAML_OK;
+}
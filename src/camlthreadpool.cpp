@@ -0,0 +1,289 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <system_error>
+#include <thread>
+
+#include "camlthreadpool.h"
+
+using namespace std;
+
+// Chunks of parallelFor() per worker, so that a worker which is done early can steal the rest.
+#define CHUNKS_PER_THREAD   4
+
+#define NO_QUEUE            SIZE_MAX
+
+// Pool and queue of the worker running on this thread, if any.
+static thread_local AmlThreadPool* t_pool = NULL;
+static thread_local size_t t_queue = NO_QUEUE;
+
+static mutex g_poolMtx;
+static shared_ptr<AmlThreadPool> g_pool;
+static size_t g_poolSize = 0;
+
+typedef struct
+{
+    atomic<size_t> remaining;   // chunks not done yet
+    mutex mtx;
+    condition_variable cv;
+} ParallelForState;
+
+AmlThreadPool::AmlThreadPool(size_t threads)
+    : m_nextQueue(0), m_pending(0), m_stop(false)
+{
+    for (size_t i = 0; i < threads; i++)
+    {
+        m_queues.push_back(unique_ptr<WorkQueue>(new WorkQueue));
+    }
+}
+
+shared_ptr<AmlThreadPool> AmlThreadPool::Create(size_t threads)
+{
+    shared_ptr<AmlThreadPool> pool(new AmlThreadPool(threads));
+    try
+    {
+        for (size_t i = 0; i < threads; i++)
+        {
+            thread([pool, i]()
+            {
+                pool->work(i);
+            }).detach();
+        }
+    }
+    catch (const system_error&)
+    {
+        pool->shutdown();
+        throw;
+    }
+
+    return pool;
+}
+
+size_t AmlThreadPool::size() const
+{
+    return m_queues.size();
+}
+
+void AmlThreadPool::push(size_t queue, const Task& task)
+{
+    // Counted after it is queued, since push_back() can throw.
+    lock_guard<mutex> lock(m_queues[queue]->mtx);
+    m_queues[queue]->tasks.push_back(task);
+    m_pending++;
+}
+
+bool AmlThreadPool::submit(const Task& task)
+{
+    {
+        // Workers exit only when nothing is pending after shutdown, so the task is queued under the same lock.
+        lock_guard<mutex> lock(m_mtx);
+        if (m_stop)
+        {
+            return false;
+        }
+
+        size_t queue = (this == t_pool) ? t_queue : m_nextQueue++ % m_queues.size();
+        push(queue, task);
+    }
+    m_cv.notify_one();
+
+    return true;
+}
+
+bool AmlThreadPool::take(size_t self, Task& task)
+{
+    if (NO_QUEUE != self)
+    {
+        WorkQueue& own = *m_queues[self];
+        lock_guard<mutex> lock(own.mtx);
+        if (!own.tasks.empty())
+        {
+            task.swap(own.tasks.back());
+            own.tasks.pop_back();
+            m_pending--;
+            return true;
+        }
+    }
+
+    size_t start = (NO_QUEUE == self) ? 0 : self + 1;
+    for (size_t i = 0; i < m_queues.size(); i++)
+    {
+        WorkQueue& victim = *m_queues[(start + i) % m_queues.size()];
+        lock_guard<mutex> lock(victim.mtx);
+        if (!victim.tasks.empty())
+        {
+            task.swap(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_pending--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AmlThreadPool::work(size_t self)
+{
+    t_pool = this;
+    t_queue = self;
+
+    for (;;)
+    {
+        Task task;
+        if (take(self, task))
+        {
+            task();
+            continue;
+        }
+
+        unique_lock<mutex> lock(m_mtx);
+        m_cv.wait(lock, [this]()
+        {
+            return m_stop || 0 < m_pending;
+        });
+        if (m_stop && 0 == m_pending)
+        {
+            return;
+        }
+    }
+}
+
+void AmlThreadPool::parallelFor(size_t count, const function<void(size_t)>& body)
+{
+    if (0 == count)
+    {
+        return;
+    }
+
+    size_t chunks = m_queues.size() * CHUNKS_PER_THREAD;
+    if (chunks > count)
+    {
+        chunks = count;
+    }
+
+    shared_ptr<ParallelForState> state(new ParallelForState);
+    state->remaining = chunks;
+
+    // Help with the queued tasks instead of waiting idle.
+    size_t self = (this == t_pool) ? t_queue : NO_QUEUE;
+    auto wait = [this, self, &state]()
+    {
+        while (0 < state->remaining)
+        {
+            Task task;
+            if (take(self, task))
+            {
+                task();
+                continue;
+            }
+
+            unique_lock<mutex> lock(state->mtx);
+            state->cv.wait(lock, [&state]()
+            {
+                return 0 == state->remaining;
+            });
+        }
+    };
+
+    size_t submitted = 0;
+    try
+    {
+        for (; submitted < chunks; submitted++)
+        {
+            size_t begin = count * submitted / chunks;
+            size_t end = count * (submitted + 1) / chunks;
+            Task chunk = [state, &body, begin, end]()
+            {
+                for (size_t index = begin; index < end; index++)
+                {
+                    body(index);
+                }
+
+                if (1 == state->remaining--)
+                {
+                    lock_guard<mutex> lock(state->mtx);
+                    state->cv.notify_all();
+                }
+            };
+
+            if (!submit(chunk))
+            {
+                chunk();
+            }
+        }
+    }
+    catch (...)
+    {
+        // Chunks which are queued refer to 'body', so they are done before the exception leaves.
+        state->remaining -= chunks - submitted;
+        wait();
+        throw;
+    }
+
+    wait();
+}
+
+void AmlThreadPool::shutdown()
+{
+    {
+        lock_guard<mutex> lock(m_mtx);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+}
+
+static size_t ThreadCount(size_t threads)
+{
+    if (0 == threads)
+    {
+        threads = thread::hardware_concurrency();
+    }
+    return (0 == threads) ? 1 : threads;
+}
+
+shared_ptr<AmlThreadPool> AcquireThreadPool()
+{
+    lock_guard<mutex> lock(g_poolMtx);
+    if (!g_pool)
+    {
+        g_pool = AmlThreadPool::Create(ThreadCount(g_poolSize));
+    }
+    return g_pool;
+}
+
+void SetThreadPoolSize(size_t threads)
+{
+    shared_ptr<AmlThreadPool> old;
+    {
+        lock_guard<mutex> lock(g_poolMtx);
+        g_poolSize = threads;
+        old.swap(g_pool);
+    }
+
+    // Conversions which already hold the old pool finish on it.
+    if (old)
+    {
+        old->shutdown();
+    }
+}
+
+size_t GetThreadPoolSize()
+{
+    lock_guard<mutex> lock(g_poolMtx);
+    return g_pool ? g_pool->size() : ThreadCount(g_poolSize);
+}
@@ -15,15 +15,29 @@
  *
  *******************************************************************************/
 
+#include <errno.h>
+#include <unistd.h>
 #include <string>
 #include <cstring>
 #include <vector>
+#include <map>
 
 #include "camlutils.h"
 
 using namespace std;
+using namespace AML;
 
-char* ConvertStringToCharStr(std::string str)
+// Scratch string which grew larger than this is released, not to keep a big buffer per thread.
+#define SCRATCH_KEEP_SIZE       (1024 * 1024)
+
+// Assumed sizes of allocations which are not visible through the API, used by EstimateMemoryUsage().
+// Typical red-black tree node header of std::map (color, parent, left, right).
+#define MAP_NODE_HEADER_SIZE    (4 * sizeof(void*))
+
+// Typical holder in which AMLData keeps each value (type tag + pointer to the value).
+#define AML_VALUE_HOLDER_SIZE   (2 * sizeof(void*))
+
+char* ConvertStringToCharStr(const std::string& str)
 {
     size_t size = str.size();
     char* cstr = (char*)malloc(sizeof(char) * (size + 1));
@@ -82,4 +96,272 @@ CAMLErrorCode ExceptionCodeToErrorCode(AML::ResultCode result)
         case AML::API_NOT_ENABLED :         return CAML_API_NOT_ENABLED;
         default : /* AML::NO_ERROR */       return CAML_OK;
     }
-}
\ No newline at end of file
+}
+
+// Accepts the form written by FormatEpoch() only, so that the string can be restored exactly from the number.
+bool ParseEpoch(const string& str, int64_t* epoch)
+{
+    size_t size = str.size();
+    if (0 == size || size > 19 || ('0' == str[0] && 1 != size))
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            return false;
+        }
+        value = value * 10 + (uint64_t)(str[i] - '0');
+    }
+
+    if (value > (uint64_t)INT64_MAX)
+    {
+        return false;
+    }
+
+    *epoch = (int64_t)value;
+    return true;
+}
+
+string FormatEpoch(int64_t epoch)
+{
+    char buf[20];
+    size_t pos = sizeof(buf);
+    uint64_t value = (uint64_t)epoch;
+
+    do
+    {
+        buf[--pos] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    return string(buf + pos, sizeof(buf) - pos);
+}
+
+static size_t GetHeapUsage(const string& str)
+{
+    const char* data = str.data();
+    const char* self = reinterpret_cast<const char*>(&str);
+
+    // Short strings are stored inside the string object itself.
+    if (data >= self && data < self + sizeof(string))
+    {
+        return 0;
+    }
+    return str.capacity() + 1;
+}
+
+static size_t GetHeapUsage(const vector<string>& strArr)
+{
+    size_t size = strArr.capacity() * sizeof(string);
+    for (const string& str : strArr)
+    {
+        size += GetHeapUsage(str);
+    }
+    return size;
+}
+
+static size_t GetHeapUsage(const AMLData& amlData)
+{
+    size_t size = 0;
+    vector<string> keys = amlData.getKeys();
+
+    for (const string& key : keys)
+    {
+        size += MAP_NODE_HEADER_SIZE + sizeof(pair<const string, void*>) + AML_VALUE_HOLDER_SIZE;
+        size += GetHeapUsage(key);
+
+        switch (amlData.getValueType(key))
+        {
+            case AMLValueType::String :
+                size += sizeof(string) + GetHeapUsage(amlData.getValueToStr(key));
+                break;
+            case AMLValueType::StringArray :
+                size += sizeof(vector<string>) + GetHeapUsage(amlData.getValueToStrArr(key));
+                break;
+            default : /* AMLValueType::AMLData */
+                size += sizeof(AMLData) + GetHeapUsage(amlData.getValueToAMLData(key));
+                break;
+        }
+    }
+
+    return size;
+}
+
+size_t EstimateMemoryUsage(const AMLData& amlData)
+{
+    return sizeof(AMLData) + GetHeapUsage(amlData);
+}
+
+size_t EstimateMemoryUsage(const AMLObject& amlObj)
+{
+    size_t size = sizeof(AMLObject);
+    size += GetHeapUsage(amlObj.getDeviceId());
+    size += GetHeapUsage(amlObj.getTimeStamp());
+    size += GetHeapUsage(amlObj.getId());
+
+    vector<string> names = amlObj.getDataNames();
+    for (const string& name : names)
+    {
+        size += MAP_NODE_HEADER_SIZE + sizeof(pair<const string, AMLData>);
+        size += GetHeapUsage(name);
+        size += GetHeapUsage(amlObj.getData(name));
+    }
+
+    return size;
+}
+
+size_t EncodeVarint(uint8_t* out, uint64_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        out[size++] = (uint8_t)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+void AppendVarint(std::string& out, uint64_t value)
+{
+    uint8_t bytes[VARINT_MAX_SIZE];
+    out.append((const char*)bytes, EncodeVarint(bytes, value));
+}
+
+bool ReadVarint(const uint8_t** pos, const uint8_t* end, uint64_t* value)
+{
+    uint64_t result = 0;
+    const uint8_t* p = *pos;
+
+    for (unsigned int shift = 0; shift < 64 && p < end; shift += 7)
+    {
+        uint8_t b = *p++;
+        result |= (uint64_t)(b & 0x7F) << shift;
+        if (0 == (b & 0x80))
+        {
+            *pos = p;
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ReadSection(const uint8_t** pos, const uint8_t* end, const uint8_t** section, size_t* size)
+{
+    uint64_t length;
+    if (!ReadVarint(pos, end, &length) || length > (uint64_t)(end - *pos))
+    {
+        return false;
+    }
+
+    *section = *pos;
+    *size = (size_t)length;
+    *pos += length;
+    return true;
+}
+
+uint64_t HashFnv1a(const char* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (uint8_t)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// CRC-32C (Castagnoli), reflected polynomial.
+#define CRC32C_POLY     0x82F63B78u
+
+static const uint32_t* Crc32cTable(void)
+{
+    static uint32_t table[256];
+    static bool init = [](){
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : (crc >> 1);
+            }
+            table[i] = crc;
+        }
+        return true;
+    }();
+    (void)init;
+    return table;
+}
+
+uint32_t Crc32c(const uint8_t* data, size_t size)
+{
+    const uint32_t* table = Crc32cTable();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool WriteAll(int fd, const char* buffer, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, buffer, size);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return false;
+        }
+        buffer += written;
+        size -= written;
+    }
+    return true;
+}
+
+static thread_local string t_scratch;
+static thread_local bool t_scratchInUse = false;
+
+ScratchBuffer::ScratchBuffer(const char* data, size_t size)
+{
+    if (t_scratchInUse)
+    {
+        m_str = &m_own;
+        m_str->assign(data, size);
+    }
+    else
+    {
+        // The destructor is not called if assign() throws, so the flag is set only after it succeeds.
+        m_str = &t_scratch;
+        m_str->assign(data, size);
+        t_scratchInUse = true;
+    }
+}
+
+ScratchBuffer::~ScratchBuffer()
+{
+    if (m_str == &t_scratch)
+    {
+        if (t_scratch.capacity() > SCRATCH_KEEP_SIZE)
+        {
+            string().swap(t_scratch);
+        }
+        t_scratchInUse = false;
+    }
+}
+
+const string& ScratchBuffer::str() const
+{
+    return *m_str;
+}
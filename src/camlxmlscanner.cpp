@@ -0,0 +1,363 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "AMLException.h"
+
+#include "camlxmlscanner.h"
+
+using namespace std;
+using namespace AML;
+
+static const char* FindStr(const char* begin, const char* end, const char* str)
+{
+    size_t size = strlen(str);
+    for (const char* pos = begin; pos + size <= end; pos++)
+    {
+        if (0 == memcmp(pos, str, size))
+        {
+            return pos;
+        }
+    }
+    return NULL;
+}
+
+static bool StartsWith(const char* begin, const char* end, const char* str)
+{
+    size_t size = strlen(str);
+    return (size_t)(end - begin) >= size && 0 == memcmp(begin, str, size);
+}
+
+static bool IsSpace(char c)
+{
+    return ' ' == c || '\t' == c || '\r' == c || '\n' == c;
+}
+
+static bool IsNameEnd(char c)
+{
+    return IsSpace(c) || '/' == c || '>' == c;
+}
+
+XmlScanner::XmlScanner(const char* data, size_t size, bool partial)
+    : m_begin(data), m_pos(data), m_end(data + size), m_partial(partial)
+{
+}
+
+size_t XmlScanner::scanned() const
+{
+    return m_pos - m_begin;
+}
+
+bool XmlScanner::next(XmlToken& token)
+{
+    if (m_pos >= m_end)
+    {
+        return false;
+    }
+
+    const char* begin = m_pos;
+    token.begin = begin;
+    token.name = NULL;
+    token.nameSize = 0;
+
+    if ('<' != *begin)
+    {
+        const char* lt = (const char*)memchr(begin, '<', m_end - begin);
+        if (!lt && m_partial)
+        {
+            return false;
+        }
+        token.type = XML_TOKEN_TEXT;
+        token.end = lt ? lt : m_end;
+        m_pos = token.end;
+        return true;
+    }
+
+    const char* close = NULL;
+    if (StartsWith(begin, m_end, "<!--"))
+    {
+        token.type = XML_TOKEN_COMMENT;
+        close = FindStr(begin + 4, m_end, "-->");
+        token.end = close ? close + 3 : NULL;
+    }
+    else if (StartsWith(begin, m_end, "<![CDATA["))
+    {
+        token.type = XML_TOKEN_CDATA;
+        close = FindStr(begin + 9, m_end, "]]>");
+        token.end = close ? close + 3 : NULL;
+    }
+    else if (StartsWith(begin, m_end, "<?"))
+    {
+        token.type = XML_TOKEN_DECLARATION;
+        close = FindStr(begin + 2, m_end, "?>");
+        token.end = close ? close + 2 : NULL;
+    }
+    else if (StartsWith(begin, m_end, "<!"))
+    {
+        token.type = XML_TOKEN_DECLARATION;
+        close = (const char*)memchr(begin, '>', m_end - begin);
+        token.end = close ? close + 1 : NULL;
+    }
+    else
+    {
+        // A tag ends at the first '>' which is not in a quoted attribute value.
+        char quote = 0;
+        const char* pos = begin + 1;
+        for (; pos < m_end; pos++)
+        {
+            if (quote)
+            {
+                if (*pos == quote)
+                {
+                    quote = 0;
+                }
+            }
+            else if ('"' == *pos || '\'' == *pos)
+            {
+                quote = *pos;
+            }
+            else if ('>' == *pos)
+            {
+                break;
+            }
+        }
+        if (pos >= m_end)
+        {
+            if (m_partial)
+            {
+                return false;
+            }
+            throw AMLException(INVALID_XML_STR);
+        }
+        token.end = pos + 1;
+
+        const char* name = begin + 1;
+        if ('/' == *name)
+        {
+            token.type = XML_TOKEN_END_TAG;
+            name++;
+        }
+        else
+        {
+            token.type = ('/' == pos[-1]) ? XML_TOKEN_EMPTY_TAG : XML_TOKEN_START_TAG;
+        }
+
+        const char* nameEnd = name;
+        while (nameEnd < pos && !IsNameEnd(*nameEnd))
+        {
+            nameEnd++;
+        }
+        if (nameEnd == name)
+        {
+            throw AMLException(INVALID_XML_STR);
+        }
+        token.name = name;
+        token.nameSize = nameEnd - name;
+    }
+
+    if (NULL == token.end)
+    {
+        if (m_partial)
+        {
+            return false;
+        }
+        throw AMLException(INVALID_XML_STR);
+    }
+
+    m_pos = token.end;
+    return true;
+}
+
+bool FindXmlAttribute(const XmlToken& token, const char* name, const char** value, size_t* size)
+{
+    size_t nameSize = strlen(name);
+    const char* pos = token.name + token.nameSize;
+    const char* end = token.end - 1;
+
+    while (pos < end)
+    {
+        while (pos < end && (IsSpace(*pos) || '/' == *pos))
+        {
+            pos++;
+        }
+
+        const char* attrName = pos;
+        while (pos < end && '=' != *pos && !IsSpace(*pos))
+        {
+            pos++;
+        }
+        const char* attrNameEnd = pos;
+
+        while (pos < end && (IsSpace(*pos) || '=' == *pos))
+        {
+            pos++;
+        }
+        if (pos >= end || ('"' != *pos && '\'' != *pos))
+        {
+            return false;
+        }
+
+        char quote = *pos++;
+        const char* attrValue = pos;
+        while (pos < end && quote != *pos)
+        {
+            pos++;
+        }
+        if (pos >= end)
+        {
+            return false;
+        }
+
+        if ((size_t)(attrNameEnd - attrName) == nameSize && 0 == memcmp(attrName, name, nameSize))
+        {
+            *value = attrValue;
+            *size = pos - attrValue;
+            return true;
+        }
+        pos++;
+    }
+
+    return false;
+}
+
+bool GetXmlAttribute(const XmlToken& token, const char* name, string& value)
+{
+    const char* attrValue = NULL;
+    size_t size = 0;
+    if (!FindXmlAttribute(token, name, &attrValue, &size))
+    {
+        return false;
+    }
+
+    value.assign(attrValue, size);
+    return true;
+}
+
+static void AppendUtf8(uint32_t code, string& out)
+{
+    if (code < 0x80)
+    {
+        out += (char)code;
+    }
+    else if (code < 0x800)
+    {
+        out += (char)(0xC0 | (code >> 6));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        out += (char)(0xE0 | (code >> 12));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+    else
+    {
+        out += (char)(0xF0 | (code >> 18));
+        out += (char)(0x80 | ((code >> 12) & 0x3F));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+static void AppendReference(const char* begin, const char* end, string& out)
+{
+    size_t size = end - begin;
+    if (2 <= size && '#' == begin[0])
+    {
+        bool hex = ('x' == begin[1]);
+        const char* digit = begin + (hex ? 2 : 1);
+        if (digit == end)
+        {
+            throw AMLException(INVALID_XML_STR);
+        }
+
+        uint32_t code = 0;
+        for (; digit < end; digit++)
+        {
+            char c = *digit;
+            uint32_t value;
+            if ('0' <= c && c <= '9')
+            {
+                value = c - '0';
+            }
+            else if (hex && 'a' <= (c | 0x20) && (c | 0x20) <= 'f')
+            {
+                value = (c | 0x20) - 'a' + 10;
+            }
+            else
+            {
+                throw AMLException(INVALID_XML_STR);
+            }
+
+            code = code * (hex ? 16 : 10) + value;
+            if (code > 0x10FFFF)
+            {
+                throw AMLException(INVALID_XML_STR);
+            }
+        }
+        AppendUtf8(code, out);
+    }
+    else if (2 == size && 0 == memcmp(begin, "lt", 2))
+    {
+        out += '<';
+    }
+    else if (2 == size && 0 == memcmp(begin, "gt", 2))
+    {
+        out += '>';
+    }
+    else if (3 == size && 0 == memcmp(begin, "amp", 3))
+    {
+        out += '&';
+    }
+    else if (4 == size && 0 == memcmp(begin, "quot", 4))
+    {
+        out += '"';
+    }
+    else if (4 == size && 0 == memcmp(begin, "apos", 4))
+    {
+        out += '\'';
+    }
+    else
+    {
+        throw AMLException(INVALID_XML_STR);
+    }
+}
+
+void AppendXmlText(const char* begin, const char* end, string& out)
+{
+    while (begin < end)
+    {
+        const char* amp = (const char*)memchr(begin, '&', end - begin);
+        if (NULL == amp)
+        {
+            out.append(begin, end - begin);
+            return;
+        }
+        out.append(begin, amp - begin);
+
+        const char* semicolon = (const char*)memchr(amp, ';', end - amp);
+        if (NULL == semicolon)
+        {
+            throw AMLException(INVALID_XML_STR);
+        }
+        AppendReference(amp + 1, semicolon, out);
+        begin = semicolon + 1;
+    }
+}
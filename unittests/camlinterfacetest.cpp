@@ -18,6 +18,7 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <thread>
 
 #include "camlinterface.h"
 #include "camlerrorcodes.h"
@@ -846,4 +847,547 @@ namespace camlinterfacetest
 
         EXPECT_EQ(AMLObject_GetDataNames(amlObj, &dataNames, &size), CAML_INVALID_HANDLE);
     }
+
+    //AMLPatch Test
+    TEST(AMLObject_DiffTest, Valid)
+    {
+        amlDataHandle_t prevData;
+        CreateAMLData(&prevData);
+        AMLData_SetValueStr(prevData, "key1", "value1");
+        AMLData_SetValueStr(prevData, "key2", "value2");
+
+        amlDataHandle_t currData;
+        CreateAMLData(&currData);
+        AMLData_SetValueStr(currData, "key1", "value1");
+        AMLData_SetValueStr(currData, "key2", "changed");
+
+        amlObjectHandle_t prevObj, currObj;
+        CreateAMLObject("deviceId", "timeStamp1", &prevObj);
+        CreateAMLObject("deviceId", "timeStamp2", &currObj);
+        AMLObject_AddData(prevObj, "dataName", prevData);
+        AMLObject_AddData(currObj, "dataName", currData);
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(AMLObject_Diff(prevObj, currObj, &patch), CAML_OK);
+
+        size_t count;
+        EXPECT_EQ(AMLPatch_GetChangeCount(patch, &count), CAML_OK);
+        EXPECT_EQ(count, (size_t)1);
+
+        EXPECT_EQ(DestroyAMLPatch(patch), CAML_OK);
+
+        EXPECT_EQ(AMLObject_Diff(currObj, currObj, &patch), CAML_OK);
+        EXPECT_EQ(AMLPatch_GetChangeCount(patch, &count), CAML_OK);
+        EXPECT_EQ(count, (size_t)0);
+
+        DestroyAMLPatch(patch);
+        DestroyAMLData(prevData);
+        DestroyAMLData(currData);
+        DestroyAMLObject(prevObj);
+        DestroyAMLObject(currObj);
+    }
+
+    TEST(AMLObject_DiffTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+        DestroyAMLObject(amlObj);
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(AMLObject_Diff(amlObj, amlObj, &patch), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLObject_ApplyPatchTest, Valid)
+    {
+        amlDataHandle_t nested;
+        CreateAMLData(&nested);
+        AMLData_SetValueStr(nested, "x", "20");
+
+        amlDataHandle_t prevData;
+        CreateAMLData(&prevData);
+        AMLData_SetValueStr(prevData, "key1", "value1");
+        AMLData_SetValueStr(prevData, "removed", "value");
+        AMLData_SetValueAMLData(prevData, "nested", nested);
+
+        amlDataHandle_t changedNested;
+        CreateAMLData(&changedNested);
+        AMLData_SetValueStr(changedNested, "x", "30");
+
+        amlDataHandle_t currData;
+        CreateAMLData(&currData);
+        const char* arr[2] = {"1", "2"};
+        AMLData_SetValueStrArr(currData, "key1", arr, 2);
+        AMLData_SetValueStr(currData, "added", "value");
+        AMLData_SetValueAMLData(currData, "nested", changedNested);
+
+        amlObjectHandle_t prevObj, currObj;
+        CreateAMLObject("deviceId", "timeStamp1", &prevObj);
+        CreateAMLObject("deviceId", "timeStamp2", &currObj);
+        AMLObject_AddData(prevObj, "dataName", prevData);
+        AMLObject_AddData(prevObj, "removedName", prevData);
+        AMLObject_AddData(currObj, "dataName", currData);
+        AMLObject_AddData(currObj, "addedName", nested);
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(AMLObject_Diff(prevObj, currObj, &patch), CAML_OK);
+
+        amlObjectHandle_t result;
+        EXPECT_EQ(AMLObject_ApplyPatch(prevObj, patch, &result), CAML_OK);
+        EXPECT_TRUE(isEqualAMLObject(currObj, result));
+
+        DestroyAMLObject(result);
+        DestroyAMLPatch(patch);
+        DestroyAMLData(nested);
+        DestroyAMLData(prevData);
+        DestroyAMLData(changedNested);
+        DestroyAMLData(currData);
+        DestroyAMLObject(prevObj);
+        DestroyAMLObject(currObj);
+    }
+
+    TEST(AMLObject_ApplyPatchTest, NotMatchedBase)
+    {
+        amlDataHandle_t amlData;
+        CreateAMLData(&amlData);
+        AMLData_SetValueStr(amlData, "key", "value");
+
+        amlObjectHandle_t emptyObj, amlObj, otherDevice;
+        CreateAMLObject("deviceId", "timeStamp", &emptyObj);
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+        CreateAMLObject("otherDeviceId", "timeStamp", &otherDevice);
+        AMLObject_AddData(amlObj, "dataName", amlData);
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(AMLObject_Diff(amlObj, emptyObj, &patch), CAML_OK);
+
+        amlObjectHandle_t result;
+        EXPECT_EQ(AMLObject_ApplyPatch(emptyObj, patch, &result), CAML_INVALID_PARAM);
+        EXPECT_EQ(AMLObject_ApplyPatch(otherDevice, patch, &result), CAML_INVALID_PARAM);
+
+        DestroyAMLPatch(patch);
+        DestroyAMLData(amlData);
+        DestroyAMLObject(emptyObj);
+        DestroyAMLObject(amlObj);
+        DestroyAMLObject(otherDevice);
+    }
+
+    TEST(DestroyAMLPatchTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        amlPatchHandle_t patch;
+        AMLObject_Diff(amlObj, amlObj, &patch);
+        EXPECT_EQ(DestroyAMLPatch(patch), CAML_OK);
+
+        EXPECT_EQ(DestroyAMLPatch(patch), CAML_INVALID_HANDLE);
+
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_GetEstimatedMemoryUsageTest, Valid)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        size_t emptySize;
+        EXPECT_EQ(AMLObject_GetEstimatedMemoryUsage(amlObj, &emptySize), CAML_OK);
+        EXPECT_GT(emptySize, (size_t)0);
+
+        amlDataHandle_t amlData;
+        CreateAMLData(&amlData);
+        AMLData_SetValueStr(amlData, "key", "a value which does not fit in a short string buffer");
+        AMLObject_AddData(amlObj, "dataName", amlData);
+
+        size_t dataSize;
+        EXPECT_EQ(AMLData_GetEstimatedMemoryUsage(amlData, &dataSize), CAML_OK);
+
+        size_t size;
+        EXPECT_EQ(AMLObject_GetEstimatedMemoryUsage(amlObj, &size), CAML_OK);
+        EXPECT_GT(size, emptySize + strlen("a value which does not fit in a short string buffer"));
+
+        DestroyAMLData(amlData);
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_GetEstimatedMemoryUsageTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+        DestroyAMLObject(amlObj);
+
+        size_t size;
+        EXPECT_EQ(AMLObject_GetEstimatedMemoryUsage(amlObj, &size), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLData_GetEstimatedMemoryUsageTest, Valid)
+    {
+        amlDataHandle_t amlData;
+        CreateAMLData(&amlData);
+
+        size_t emptySize;
+        EXPECT_EQ(AMLData_GetEstimatedMemoryUsage(amlData, &emptySize), CAML_OK);
+
+        const char* value[2] = {"value1", "value2"};
+        AMLData_SetValueStrArr(amlData, "key", value, 2);
+
+        size_t size;
+        EXPECT_EQ(AMLData_GetEstimatedMemoryUsage(amlData, &size), CAML_OK);
+        EXPECT_GT(size, emptySize);
+
+        DestroyAMLData(amlData);
+    }
+
+    TEST(AMLData_GetEstimatedMemoryUsageTest, InvalidHandle)
+    {
+        amlDataHandle_t amlData;
+        CreateAMLData(&amlData);
+        DestroyAMLData(amlData);
+
+        size_t size;
+        EXPECT_EQ(AMLData_GetEstimatedMemoryUsage(amlData, &size), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLObject_CreateWithEpochTest, Valid)
+    {
+        amlObjectHandle_t amlObj;
+        EXPECT_EQ(CreateAMLObjectWithEpoch("deviceId", 1530000000123LL, &amlObj), CAML_OK);
+
+        int64_t epoch;
+        EXPECT_EQ(AMLObject_GetEpoch(amlObj, &epoch), CAML_OK);
+        EXPECT_EQ(epoch, 1530000000123LL);
+
+        char* timeStamp;
+        EXPECT_EQ(AMLObject_GetTimeStamp(amlObj, &timeStamp), CAML_OK);
+        EXPECT_TRUE(isEqual("1530000000123", timeStamp));
+
+        free(timeStamp);
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_CreateWithEpochTest, Invalid_Parameter)
+    {
+        amlObjectHandle_t amlObj;
+        EXPECT_EQ(CreateAMLObjectWithEpoch("deviceId", -1, &amlObj), CAML_INVALID_PARAM);
+        EXPECT_EQ(CreateAMLObjectWithEpoch("", 0, &amlObj), CAML_INVALID_PARAM);
+    }
+
+    TEST(AMLObject_GetEpochTest, NotNumber)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        int64_t epoch;
+        EXPECT_EQ(AMLObject_GetEpoch(amlObj, &epoch), CAML_WRONG_GETTER_TYPE);
+
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_GetEpochTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObjectWithEpoch("deviceId", 0, &amlObj);
+        DestroyAMLObject(amlObj);
+
+        int64_t epoch;
+        EXPECT_EQ(AMLObject_GetEpoch(amlObj, &epoch), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLObject_CreateObjectsTest, Valid)
+    {
+        const char* deviceIds[3] = {"deviceId1", "deviceId2", "deviceId3"};
+        const char* timeStamps[3] = {"timeStamp1", "timeStamp2", "timeStamp3"};
+
+        amlObjectHandle_t amlObjs[3];
+        EXPECT_EQ(CreateAMLObjects(deviceIds, timeStamps, 3, amlObjs), CAML_OK);
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            char* deviceId;
+            EXPECT_EQ(AMLObject_GetDeviceId(amlObjs[i], &deviceId), CAML_OK);
+            EXPECT_TRUE(isEqual(deviceIds[i], deviceId));
+            free(deviceId);
+        }
+
+        EXPECT_EQ(DestroyAMLObject(amlObjs[1]), CAML_OK);
+
+        amlObjectHandle_t remains[2] = {amlObjs[0], amlObjs[2]};
+        EXPECT_EQ(DestroyAMLObjects(remains, 2), CAML_OK);
+    }
+
+    TEST(AMLObject_CreateObjectsTest, Invalid_Parameter)
+    {
+        const char* deviceIds[2] = {"deviceId1", ""};
+        const char* timeStamps[2] = {"timeStamp1", "timeStamp2"};
+
+        amlObjectHandle_t amlObjs[2];
+        EXPECT_EQ(CreateAMLObjects(deviceIds, timeStamps, 2, amlObjs), CAML_INVALID_PARAM);
+    }
+
+    TEST(AMLObject_DestroyObjectsTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObjs[2];
+        CreateAMLObject("deviceId", "timeStamp", &amlObjs[0]);
+        CreateAMLObject("deviceId", "timeStamp", &amlObjs[1]);
+        DestroyAMLObject(amlObjs[1]);
+
+        EXPECT_EQ(DestroyAMLObjects(amlObjs, 2), CAML_INVALID_HANDLE);
+
+        amlObjectHandle_t duplicated[2] = {amlObjs[0], amlObjs[0]};
+        EXPECT_EQ(DestroyAMLObjects(duplicated, 2), CAML_INVALID_HANDLE);
+
+        EXPECT_EQ(DestroyAMLObject(amlObjs[0]), CAML_OK);
+    }
+
+    TEST(AMLData_DestroyBatchTest, Valid)
+    {
+        amlDataHandle_t amlDatas[2];
+        CreateAMLData(&amlDatas[0]);
+        CreateAMLData(&amlDatas[1]);
+
+        EXPECT_EQ(DestroyAMLDataBatch(amlDatas, 2), CAML_OK);
+        EXPECT_EQ(DestroyAMLData(amlDatas[0]), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLData_DestroyBatchTest, InvalidHandle)
+    {
+        amlDataHandle_t amlDatas[2];
+        CreateAMLData(&amlDatas[0]);
+        CreateAMLData(&amlDatas[1]);
+        DestroyAMLData(amlDatas[1]);
+
+        EXPECT_EQ(DestroyAMLDataBatch(amlDatas, 2), CAML_INVALID_HANDLE);
+
+        EXPECT_EQ(DestroyAMLData(amlDatas[0]), CAML_OK);
+    }
+
+    TEST(AMLObject_GetDataAtTest, Valid)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        amlDataHandle_t data1, data2;
+        CreateAMLData(&data1);
+        CreateAMLData(&data2);
+        AMLData_SetValueStr(data1, "key", "value1");
+        AMLData_SetValueStr(data2, "key", "value2");
+        AMLObject_AddData(amlObj, "name2", data2);
+
+        size_t count;
+        EXPECT_EQ(AMLObject_GetDataCount(amlObj, &count), CAML_OK);
+        EXPECT_EQ(count, 1u);
+
+        AMLObject_AddData(amlObj, "name1", data1);
+        EXPECT_EQ(AMLObject_GetDataCount(amlObj, &count), CAML_OK);
+        EXPECT_EQ(count, 2u);
+
+        const char* name;
+        amlDataHandle_t data;
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 0, &name, &data), CAML_OK);
+        EXPECT_TRUE(isEqual(name, "name1"));
+
+        char* value;
+        EXPECT_EQ(AMLData_GetValueStr(data, "key", &value), CAML_OK);
+        EXPECT_TRUE(isEqual(value, "value1"));
+        free(value);
+
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 1, &name, &data), CAML_OK);
+        EXPECT_TRUE(isEqual(name, "name2"));
+
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 2, &name, &data), CAML_INVALID_PARAM);
+
+        DestroyAMLData(data1);
+        DestroyAMLData(data2);
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_GetDataAtTest, SameHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        amlDataHandle_t amlData;
+        CreateAMLData(&amlData);
+        AMLData_SetValueStr(amlData, "key", "value");
+        AMLObject_AddData(amlObj, "name", amlData);
+
+        const char* name;
+        amlDataHandle_t first, second, byName;
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 0, &name, &first), CAML_OK);
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 0, &name, &second), CAML_OK);
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(AMLObject_GetData(amlObj, "name", &byName), CAML_OK);
+        EXPECT_EQ(first, byName);
+
+        // A destroyed handle is not returned again.
+        EXPECT_EQ(DestroyAMLData(first), CAML_OK);
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 0, &name, &second), CAML_OK);
+
+        char* value;
+        EXPECT_EQ(AMLData_GetValueStr(second, "key", &value), CAML_OK);
+        EXPECT_TRUE(isEqual(value, "value"));
+        free(value);
+
+        DestroyAMLData(amlData);
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_GetDataAtTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+        DestroyAMLObject(amlObj);
+
+        size_t count;
+        EXPECT_EQ(AMLObject_GetDataCount(amlObj, &count), CAML_INVALID_HANDLE);
+
+        const char* name;
+        amlDataHandle_t data;
+        EXPECT_EQ(AMLObject_GetDataAt(amlObj, 0, &name, &data), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLObject_FreezeTest, Valid)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+
+        amlDataHandle_t nested, data;
+        CreateAMLData(&nested);
+        CreateAMLData(&data);
+        AMLData_SetValueStr(nested, "key", "value");
+        AMLData_SetValueAMLData(data, "nested", nested);
+        AMLObject_AddData(amlObj, "name", data);
+
+        EXPECT_EQ(AMLObject_Freeze(amlObj), CAML_OK);
+        EXPECT_EQ(AMLObject_Freeze(amlObj), CAML_OK);
+
+        EXPECT_EQ(AMLObject_AddData(amlObj, "name2", data), CAML_OBJECT_FROZEN);
+
+        amlDataHandle_t frozenData, frozenNested;
+        EXPECT_EQ(AMLObject_GetData(amlObj, "name", &frozenData), CAML_OK);
+        EXPECT_EQ(AMLData_SetValueStr(frozenData, "key2", "value2"), CAML_OBJECT_FROZEN);
+
+        EXPECT_EQ(AMLData_GetValueAMLData(frozenData, "nested", &frozenNested), CAML_OK);
+        EXPECT_EQ(AMLData_SetValueStr(frozenNested, "key2", "value2"), CAML_OBJECT_FROZEN);
+
+        char* value;
+        EXPECT_EQ(AMLData_GetValueStr(frozenNested, "key", &value), CAML_OK);
+        EXPECT_TRUE(isEqual(value, "value"));
+        free(value);
+
+        // AMLData added to AMLObject is a copy, so the original one is not frozen.
+        EXPECT_EQ(AMLData_SetValueStr(data, "key2", "value2"), CAML_OK);
+
+        amlObjectHandle_t clone;
+        EXPECT_EQ(CloneAMLObject(amlObj, &clone), CAML_OK);
+        EXPECT_EQ(AMLObject_AddData(clone, "name2", data), CAML_OK);
+
+        DestroyAMLData(nested);
+        DestroyAMLData(data);
+        DestroyAMLObject(clone);
+        DestroyAMLObject(amlObj);
+    }
+
+    TEST(AMLObject_FreezeTest, InvalidHandle)
+    {
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("deviceId", "timeStamp", &amlObj);
+        DestroyAMLObject(amlObj);
+
+        EXPECT_EQ(AMLObject_Freeze(amlObj), CAML_INVALID_HANDLE);
+    }
+
+    TEST(AMLObjectQueueTest, PushPop)
+    {
+        amlObjectQueue_t queue;
+        EXPECT_EQ(CreateAMLObjectQueue(0, &queue), CAML_INVALID_PARAM);
+        EXPECT_EQ(CreateAMLObjectQueue(SIZE_MAX, &queue), CAML_INVALID_PARAM);
+        EXPECT_EQ(CreateAMLObjectQueue((SIZE_MAX >> 1) + 2, &queue), CAML_INVALID_PARAM);
+        EXPECT_EQ(CreateAMLObjectQueue(2, &queue), CAML_OK);
+
+        amlObjectHandle_t amlObjs[3];
+        for (size_t i = 0; i < 3; i++)
+        {
+            CreateAMLObject("deviceId", "timeStamp", &amlObjs[i]);
+        }
+
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[0]), CAML_OK);
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[1]), CAML_OK);
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[2]), CAML_QUEUE_FULL);
+
+        amlObjectHandle_t popped;
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_OK);
+        EXPECT_EQ(popped, amlObjs[0]);
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_OK);
+        EXPECT_EQ(popped, amlObjs[1]);
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_QUEUE_EMPTY);
+
+        EXPECT_EQ(DestroyAMLObjectQueue(queue), CAML_OK);
+        EXPECT_EQ(DestroyAMLObjects(amlObjs, 3), CAML_OK);
+    }
+
+    TEST(AMLObjectQueueTest, CapacityOne)
+    {
+        amlObjectQueue_t queue;
+        EXPECT_EQ(CreateAMLObjectQueue(1, &queue), CAML_OK);
+
+        amlObjectHandle_t amlObjs[3];
+        for (size_t i = 0; i < 3; i++)
+        {
+            CreateAMLObject("deviceId", "timeStamp", &amlObjs[i]);
+        }
+
+        // The queue has 2 cells at least, so the first item is not overwritten by the second.
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[0]), CAML_OK);
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[1]), CAML_OK);
+        EXPECT_EQ(AMLObjectQueue_Push(queue, amlObjs[2]), CAML_QUEUE_FULL);
+
+        amlObjectHandle_t popped;
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_OK);
+        EXPECT_EQ(popped, amlObjs[0]);
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_OK);
+        EXPECT_EQ(popped, amlObjs[1]);
+        EXPECT_EQ(AMLObjectQueue_Pop(queue, &popped), CAML_QUEUE_EMPTY);
+
+        EXPECT_EQ(DestroyAMLObjectQueue(queue), CAML_OK);
+        EXPECT_EQ(DestroyAMLObjects(amlObjs, 3), CAML_OK);
+    }
+
+    TEST(AMLObjectQueueTest, HandOverBetweenThreads)
+    {
+        const size_t count = 1000;
+
+        amlObjectQueue_t queue;
+        CreateAMLObjectQueue(16, &queue);
+
+        thread producer([&]()
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                amlObjectHandle_t amlObj;
+                CreateAMLObject("deviceId", "timeStamp", &amlObj);
+                while (CAML_QUEUE_FULL == AMLObjectQueue_Push(queue, amlObj))
+                {
+                    this_thread::yield();
+                }
+            }
+        });
+
+        size_t received = 0;
+        while (received < count)
+        {
+            amlObjectHandle_t amlObj;
+            if (CAML_OK != AMLObjectQueue_Pop(queue, &amlObj))
+            {
+                this_thread::yield();
+                continue;
+            }
+
+            EXPECT_EQ(DestroyAMLObject(amlObj), CAML_OK);
+            received++;
+        }
+
+        producer.join();
+        DestroyAMLObjectQueue(queue);
+    }
 }
\ No newline at end of file
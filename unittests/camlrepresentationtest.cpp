@@ -18,6 +18,11 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <poll.h>
 
 #include "camlrepresentation.h"
 #include "camlinterface.h"
@@ -522,6 +527,859 @@ namespace camlrepresentationtest
         EXPECT_EQ(Representation_DataToByte(rep, amlObj, &amlBinary, &size), CAML_INVALID_HANDLE);
     }
 
+    TEST(Representation_DataToAmlBufferTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        char* amlStr;
+        Representation_DataToAml(rep, amlObj, &amlStr);
+
+        size_t size = 0;
+        EXPECT_EQ(Representation_DataToAmlBuffer(rep, amlObj, NULL, 0, &size), CAML_BUFFER_TOO_SMALL);
+        EXPECT_EQ(size, strlen(amlStr) + 1);
+
+        std::string buffer(size, 'x');
+        EXPECT_EQ(Representation_DataToAmlBuffer(rep, amlObj, &buffer[0], size - 1, &size), CAML_BUFFER_TOO_SMALL);
+        EXPECT_EQ(buffer[0], 'x');
+        EXPECT_EQ(Representation_DataToAmlBuffer(rep, amlObj, &buffer[0], size, &size), CAML_OK);
+        EXPECT_STREQ(buffer.c_str(), amlStr);
+
+        free(amlStr);
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_DataToByteBufferTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+#ifndef _DISABLE_PROTOBUF_
+        uint8_t* byte;
+        size_t byteSize;
+        Representation_DataToByte(rep, amlObj, &byte, &byteSize);
+
+        size_t size = 0;
+        EXPECT_EQ(Representation_GetSerializedSize(rep, amlObj, CAML_FORMAT_BYTE, &size), CAML_OK);
+        EXPECT_EQ(size, byteSize);
+
+        uint8_t buffer[4096];
+        ASSERT_LE(size, sizeof(buffer));
+        EXPECT_EQ(Representation_DataToByteBuffer(rep, amlObj, buffer, sizeof(buffer), &size), CAML_OK);
+        EXPECT_TRUE(isEqualBinary(buffer, size, byte, byteSize));
+
+        free(byte);
+#else
+        size_t size;
+        EXPECT_EQ(Representation_GetSerializedSize(rep, amlObj, CAML_FORMAT_BYTE, &size), CAML_API_NOT_ENABLED);
+#endif
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_GetSerializedSizeTest, InvalidParam)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        size_t size;
+        char buffer[16];
+        EXPECT_EQ(Representation_GetSerializedSize(rep, amlObj, (CAMLSerialFormat)7, &size), CAML_INVALID_PARAM);
+        EXPECT_EQ(Representation_GetSerializedSize(rep, amlObj, CAML_FORMAT_AML, NULL), CAML_INVALID_PARAM);
+        EXPECT_EQ(Representation_DataToAmlBuffer(rep, amlObj, NULL, sizeof(buffer), &size), CAML_INVALID_PARAM);
+
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    static int TraceEvent(const CAMLParseEvent* event, void* userData)
+    {
+        static const char* names[] = { "H", "D", "/D", "V", "A", "/A", "N", "/N" };
+
+        std::string* trace = (std::string*)userData;
+        trace->append(names[event->type]).append(" ").append(event->key, event->keySize);
+        if (event->value)
+        {
+            trace->append("=").append(event->value, event->valueSize);
+        }
+        trace->append(";");
+        return 0;
+    }
+
+    static int StopAtData(const CAMLParseEvent* event, void* userData)
+    {
+        (*(int*)userData)++;
+        return AMLPARSE_DATA_BEGIN == event->type;
+    }
+
+    TEST(Representation_AmlParseEventsTest, ParseValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        char* aml = TestAML();
+        std::string trace;
+        EXPECT_EQ(Representation_AmlParseEvents(rep, aml, strlen(aml), TraceEvent, &trace), CAML_OK);
+        EXPECT_EQ(trace, "H device=SAMPLE001;H id=SAMPLE001_123456789;H timestamp=123456789;"
+                         "D Model;V a=Model_107.113.97.248;V b=SR-P7-970;/D Model;"
+                         "D Sample;N info;V id=f437da3b;N axis;V x=20;V y=110;V z=80;/N axis;/N info;"
+                         "A appendix;V 1=52303;V 2=935;V 3=1442;/A appendix;/D Sample;");
+
+        int count = 0;
+        EXPECT_EQ(Representation_AmlParseEvents(rep, aml, strlen(aml), StopAtData, &count), CAML_OK);
+        EXPECT_EQ(count, 4);
+
+        delete[] aml;
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_AmlParseEventsTest, DecodeReferences)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        const char aml[] =
+            "<CAEXFile><InstanceHierarchy Name=\"IH\"><InternalElement Name=\"Event\">"
+            "<InternalElement Name=\"Model\"><Attribute Name=\"a&amp;b\"><Value>1 &lt; 2&#x21;<![CDATA[<&>]]></Value></Attribute>"
+            "<Attribute Name=\"empty\"/></InternalElement></InternalElement></InstanceHierarchy></CAEXFile>";
+        std::string trace;
+        EXPECT_EQ(Representation_AmlParseEvents(rep, aml, sizeof(aml) - 1, TraceEvent, &trace), CAML_OK);
+        EXPECT_EQ(trace, "D Model;V a&b=1 < 2!<&>;V empty=;/D Model;");
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_AmlParseEventsTest, InvalidAml)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        std::string trace;
+        const char noHierarchy[] = "<CAEXFile></CAEXFile>";
+        EXPECT_EQ(Representation_AmlParseEvents(rep, noHierarchy, sizeof(noHierarchy) - 1, TraceEvent, &trace), CAML_INVALID_AML_SCHEMA);
+
+        const char badEntity[] = "<CAEXFile><InstanceHierarchy><InternalElement Name=\"E\"><Attribute Name=\"a\">"
+                                 "<Value>&bad;</Value></Attribute></InternalElement></InstanceHierarchy></CAEXFile>";
+        EXPECT_EQ(Representation_AmlParseEvents(rep, badEntity, sizeof(badEntity) - 1, TraceEvent, &trace), CAML_INVALID_XML_STR);
+
+        const char truncated[] = "<CAEXFile><InstanceHierarchy><InternalElement Name=\"E\">";
+        EXPECT_EQ(Representation_AmlParseEvents(rep, truncated, sizeof(truncated) - 1, TraceEvent, &trace), CAML_INVALID_XML_STR);
+
+        EXPECT_EQ(Representation_AmlParseEvents(rep, noHierarchy, sizeof(noHierarchy) - 1, NULL, NULL), CAML_INVALID_PARAM);
+
+        DestroyRepresentation(rep);
+    }
+
+    static bool IsSameAsTestObject(amlObjectHandle_t amlObj)
+    {
+        amlObjectHandle_t expected = TestAMLObjectHandle();
+
+        amlPatchHandle_t patch;
+        size_t count = 1;
+        if (CAML_OK == AMLObject_Diff(expected, amlObj, &patch))
+        {
+            AMLPatch_GetChangeCount(patch, &count);
+            DestroyAMLPatch(patch);
+        }
+        DestroyAMLObject(expected);
+
+        char* id = NULL;
+        AMLObject_GetId(amlObj, &id);
+        bool sameId = (NULL != id && 0 == strcmp(id, "SAMPLE001_123456789"));
+        free(id);
+
+        return 0 == count && sameId;
+    }
+
+    TEST(AmlParserTest, ParseInChunks)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlParserHandle_t parser;
+        EXPECT_EQ(Representation_AmlParserCreate(rep, &parser), CAML_OK);
+
+        char* aml = TestAML();
+        size_t size = strlen(aml);
+        size_t chunkSizes[] = { 1, 7, 64, size };
+        for (size_t chunkSize : chunkSizes)
+        {
+            for (size_t pos = 0; pos < size; pos += chunkSize)
+            {
+                EXPECT_EQ(AmlParser_Feed(parser, aml + pos, std::min(chunkSize, size - pos)), CAML_OK);
+            }
+
+            amlObjectHandle_t amlObj = NULL;
+            EXPECT_EQ(AmlParser_Finish(parser, &amlObj), CAML_OK);
+            EXPECT_TRUE(IsSameAsTestObject(amlObj));
+            DestroyAMLObject(amlObj);
+        }
+
+        delete[] aml;
+        DestroyAmlParser(parser);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(AmlParserTest, InvalidAml)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlParserHandle_t parser;
+        Representation_AmlParserCreate(rep, &parser);
+
+        amlObjectHandle_t amlObj;
+        char* aml = TestAML();
+        EXPECT_EQ(AmlParser_Feed(parser, aml, strlen(aml) / 2), CAML_OK);
+        EXPECT_EQ(AmlParser_Finish(parser, &amlObj), CAML_INVALID_XML_STR);
+
+        const char broken[] = "<CAEXFile><InstanceHierarchy><InternalElement Name=\"E\"><Attribute Name=\"a\"><Value>&bad;<";
+        EXPECT_EQ(AmlParser_Feed(parser, broken, sizeof(broken) - 1), CAML_INVALID_XML_STR);
+        EXPECT_EQ(AmlParser_Feed(parser, aml, strlen(aml)), CAML_INVALID_XML_STR);
+        EXPECT_EQ(AmlParser_Finish(parser, &amlObj), CAML_INVALID_XML_STR);
+
+        // The parser is reset by AmlParser_Finish().
+        EXPECT_EQ(AmlParser_Feed(parser, aml, strlen(aml)), CAML_OK);
+        EXPECT_EQ(AmlParser_Finish(parser, &amlObj), CAML_OK);
+        DestroyAMLObject(amlObj);
+
+        delete[] aml;
+        DestroyAmlParser(parser);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(AmlParserTest, InvalidHandle)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+        DestroyRepresentation(rep);
+
+        amlParserHandle_t parser;
+        EXPECT_EQ(Representation_AmlParserCreate(rep, &parser), CAML_INVALID_HANDLE);
+        EXPECT_EQ(AmlParser_Feed(NULL, "<", 1), CAML_INVALID_PARAM);
+    }
+
+    TEST(Representation_ByteToDataTest, DecodeRepeatedly)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        amlObjectHandle_t small;
+        CreateAMLObject("SAMPLE001", "1", &small);
+        amlObjectHandle_t large = TestAMLObjectHandle();
+
+        uint8_t* smallByte;
+        uint8_t* largeByte;
+        size_t smallSize, largeSize;
+        Representation_DataToByte(rep, small, &smallByte, &smallSize);
+        Representation_DataToByte(rep, large, &largeByte, &largeSize);
+
+        for (int i = 0; i < 3; i++)
+        {
+            amlObjectHandle_t decoded;
+            EXPECT_EQ(Representation_ByteToData(rep, largeByte, largeSize, &decoded), CAML_OK);
+            EXPECT_TRUE(IsSameAsTestObject(decoded));
+            DestroyAMLObject(decoded);
+
+            EXPECT_EQ(Representation_ByteToData(rep, smallByte, smallSize, &decoded), CAML_OK);
+            char* timeStamp;
+            AMLObject_GetTimeStamp(decoded, &timeStamp);
+            EXPECT_STREQ(timeStamp, "1");
+            free(timeStamp);
+            DestroyAMLObject(decoded);
+        }
+
+        free(smallByte);
+        free(largeByte);
+        DestroyAMLObject(small);
+        DestroyAMLObject(large);
+#endif
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_DataToByteBatchTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        amlObjectHandle_t amlObjs[3];
+        for (int i = 0; i < 3; i++)
+        {
+            amlObjs[i] = TestAMLObjectHandle();
+        }
+
+        uint8_t* byte;
+        size_t size;
+        EXPECT_EQ(Representation_DataToByteBatch(rep, amlObjs, 3, &byte, &size), CAML_OK);
+
+        amlBatchIterator_t iterator;
+        EXPECT_EQ(Representation_ByteToDataBatch(rep, byte, size, &iterator), CAML_OK);
+
+        size_t count = 0;
+        EXPECT_EQ(AMLBatchIterator_GetCount(iterator, &count), CAML_OK);
+        EXPECT_EQ(count, 3u);
+
+        amlObjectHandle_t decoded;
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_OK);
+            EXPECT_TRUE(IsSameAsTestObject(decoded));
+            DestroyAMLObject(decoded);
+        }
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_END_OF_BATCH);
+        DestroyAMLBatchIterator(iterator);
+
+        free(byte);
+        DestroyAMLObjects(amlObjs, 3);
+#endif
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_ByteToDataBatchTest, BrokenFrame)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        uint8_t* byte;
+        size_t size;
+        Representation_DataToByteBatch(rep, &amlObj, 1, &byte, &size);
+
+        amlBatchIterator_t iterator;
+        byte[size / 2] ^= 0x01;
+        EXPECT_EQ(Representation_ByteToDataBatch(rep, byte, size, &iterator), CAML_INVALID_BYTE_STR);
+        byte[size / 2] ^= 0x01;
+        EXPECT_EQ(Representation_ByteToDataBatch(rep, byte, size - 1, &iterator), CAML_INVALID_BYTE_STR);
+
+        amlObjectHandle_t invalid[2] = { amlObj, NULL };
+        uint8_t* invalidByte;
+        EXPECT_EQ(Representation_DataToByteBatch(rep, invalid, 2, &invalidByte, &size), CAML_INVALID_HANDLE);
+
+        free(byte);
+        DestroyAMLObject(amlObj);
+#endif
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_DataToAmlBatchTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObjs[3];
+        for (int i = 0; i < 3; i++)
+        {
+            amlObjs[i] = TestAMLObjectHandle();
+        }
+
+        char* amlStr;
+        EXPECT_EQ(Representation_DataToAmlBatch(rep, amlObjs, 3, &amlStr), CAML_OK);
+
+        amlBatchIterator_t iterator;
+        EXPECT_EQ(Representation_AmlToDataBatch(rep, amlStr, &iterator), CAML_OK);
+
+        amlObjectHandle_t decoded;
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_OK);
+        EXPECT_TRUE(IsSameAsTestObject(decoded));
+        DestroyAMLObject(decoded);
+
+        size_t count = 0;
+        EXPECT_EQ(AMLBatchIterator_GetCount(iterator, &count), CAML_OK);
+        EXPECT_EQ(count, 3u);
+
+        for (int i = 1; i < 3; i++)
+        {
+            EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_OK);
+            EXPECT_TRUE(IsSameAsTestObject(decoded));
+            DestroyAMLObject(decoded);
+        }
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_END_OF_BATCH);
+        DestroyAMLBatchIterator(iterator);
+
+        amlObjectHandle_t invalid[2] = { amlObjs[0], NULL };
+        char* invalidStr;
+        EXPECT_EQ(Representation_DataToAmlBatch(rep, invalid, 2, &invalidStr), CAML_INVALID_HANDLE);
+
+        free(amlStr);
+        DestroyAMLObjects(amlObjs, 3);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_AmlToDataBatchTest, SingleDocument)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        char* aml = TestAML();
+        amlBatchIterator_t iterator;
+        EXPECT_EQ(Representation_AmlToDataBatch(rep, aml, &iterator), CAML_OK);
+
+        size_t count = 0;
+        EXPECT_EQ(AMLBatchIterator_GetCount(iterator, &count), CAML_OK);
+        EXPECT_EQ(count, 1u);
+
+        amlObjectHandle_t decoded;
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_OK);
+        EXPECT_TRUE(IsSameAsTestObject(decoded));
+        DestroyAMLObject(decoded);
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_END_OF_BATCH);
+        DestroyAMLBatchIterator(iterator);
+
+        EXPECT_EQ(Representation_AmlToDataBatch(rep, "<?xml version=\"1.0\"?>", &iterator), CAML_INVALID_AML_SCHEMA);
+
+        delete[] aml;
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_AmlToDataBatchTest, TruncatedDocument)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+        char* aml;
+        EXPECT_EQ(Representation_DataToAml(rep, amlObj, &aml), CAML_OK);
+        std::string full(aml);
+        free(aml);
+        DestroyAMLObject(amlObj);
+
+        // Ends in the middle of InstanceHierarchy.
+        std::string unterminated = full.substr(0, full.find("</InstanceHierarchy>"));
+        amlBatchIterator_t iterator;
+        EXPECT_EQ(Representation_AmlToDataBatch(rep, unterminated.c_str(), &iterator), CAML_OK);
+
+        size_t count = 0;
+        amlObjectHandle_t decoded;
+        EXPECT_EQ(AMLBatchIterator_GetCount(iterator, &count), CAML_INVALID_AML_SCHEMA);
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_INVALID_AML_SCHEMA);
+        DestroyAMLBatchIterator(iterator);
+
+        // Ends after InstanceHierarchy, but before the end tag of CAEXFile.
+        std::string truncated = full.substr(0, full.find("</CAEXFile>"));
+        EXPECT_EQ(Representation_AmlToDataBatch(rep, truncated.c_str(), &iterator), CAML_OK);
+
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_OK);
+        EXPECT_TRUE(IsSameAsTestObject(decoded));
+        DestroyAMLObject(decoded);
+        EXPECT_EQ(AMLBatchIterator_Next(iterator, &decoded), CAML_INVALID_AML_SCHEMA);
+        DestroyAMLBatchIterator(iterator);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_ConvertBatchTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        const size_t count = 64;
+        amlObjectHandle_t amlObjs[count];
+        CAMLConvertItem items[count];
+        for (size_t i = 0; i < count; i++)
+        {
+            amlObjs[i] = TestAMLObjectHandle();
+            memset(&items[i], 0, sizeof(items[i]));
+            items[i].amlObj = amlObjs[i];
+        }
+
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_AML, items, count), CAML_OK);
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_AML_TO_DATA, items, count), CAML_OK);
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(items[i].result, CAML_OK);
+            EXPECT_NE(items[i].amlObj, amlObjs[i]);
+            EXPECT_TRUE(IsSameAsTestObject(items[i].amlObj));
+            DestroyAMLObject(items[i].amlObj);
+            free(items[i].aml);
+            items[i].aml = NULL;
+            items[i].amlObj = amlObjs[i];
+        }
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_BYTE, items, count), CAML_OK);
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_BYTE_TO_DATA, items, count), CAML_OK);
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_TRUE(IsSameAsTestObject(items[i].amlObj));
+            DestroyAMLObject(items[i].amlObj);
+            free(items[i].byte);
+        }
+#endif
+        DestroyAMLObjects(amlObjs, count);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_ConvertBatchTest, ResultPerItem)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        CAMLConvertItem items[3];
+        memset(items, 0, sizeof(items));
+        items[0].amlObj = TestAMLObjectHandle();
+        items[2].amlObj = TestAMLObjectHandle();
+
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_AML, items, 3), CAML_INVALID_HANDLE);
+        EXPECT_EQ(items[0].result, CAML_OK);
+        EXPECT_EQ(items[1].result, CAML_INVALID_HANDLE);
+        EXPECT_EQ(items[2].result, CAML_OK);
+        EXPECT_TRUE(NULL != items[0].aml && NULL != items[2].aml);
+
+        EXPECT_EQ(Representation_ConvertBatch(rep, (CAMLConvertType)100, items, 3), CAML_INVALID_PARAM);
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_AML, NULL, 3), CAML_INVALID_PARAM);
+
+        free(items[0].aml);
+        free(items[2].aml);
+        DestroyAMLObject(items[0].amlObj);
+        DestroyAMLObject(items[2].amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(ConvertThreadCountTest, SetGet)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        size_t threads = 0;
+        EXPECT_EQ(SetConvertThreadCount(3), CAML_OK);
+        EXPECT_EQ(GetConvertThreadCount(&threads), CAML_OK);
+        EXPECT_EQ(threads, 3u);
+
+        CAMLConvertItem item;
+        memset(&item, 0, sizeof(item));
+        item.amlObj = TestAMLObjectHandle();
+        amlObjectHandle_t amlObj = item.amlObj;
+        EXPECT_EQ(Representation_ConvertBatch(rep, CAML_CONVERT_DATA_TO_AML, &item, 1), CAML_OK);
+
+        EXPECT_EQ(SetConvertThreadCount(0), CAML_OK);
+        EXPECT_EQ(GetConvertThreadCount(&threads), CAML_OK);
+        EXPECT_LT(0u, threads);
+        EXPECT_EQ(GetConvertThreadCount(NULL), CAML_INVALID_PARAM);
+
+        free(item.aml);
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    static void PostCompletion(const CAMLCompletion* completion)
+    {
+        AMLCompletionQueue_Post((amlCompletionQueue_t)completion->userData, completion);
+    }
+
+    // Waits for the descriptor of queue, as an event loop would.
+    static bool WaitCompletion(amlCompletionQueue_t queue, CAMLCompletion* completion)
+    {
+        int fd;
+        AMLCompletionQueue_GetFd(queue, &fd);
+
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (1 != poll(&pfd, 1, 10000))
+        {
+            return false;
+        }
+        return CAML_OK == AMLCompletionQueue_Pop(queue, completion);
+    }
+
+    TEST(Representation_AsyncTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlCompletionQueue_t queue;
+        EXPECT_EQ(CreateAMLCompletionQueue(&queue), CAML_OK);
+
+#ifndef _DISABLE_PROTOBUF_
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+        EXPECT_EQ(Representation_DataToByteAsync(rep, amlObj, PostCompletion, queue), CAML_OK);
+
+        CAMLCompletion completion;
+        ASSERT_TRUE(WaitCompletion(queue, &completion));
+        EXPECT_EQ(completion.result, CAML_OK);
+        EXPECT_EQ(completion.amlObj, amlObj);
+        EXPECT_EQ(completion.userData, queue);
+
+        EXPECT_EQ(Representation_ByteToDataAsync(rep, completion.byte, completion.size, PostCompletion, queue), CAML_OK);
+        free(completion.byte);
+
+        ASSERT_TRUE(WaitCompletion(queue, &completion));
+        EXPECT_EQ(completion.result, CAML_OK);
+        EXPECT_TRUE(IsSameAsTestObject(completion.amlObj));
+        DestroyAMLObject(completion.amlObj);
+
+        const uint8_t broken[] = { 0xff, 0xff, 0xff };
+        EXPECT_EQ(Representation_ByteToDataAsync(rep, broken, sizeof(broken), PostCompletion, queue), CAML_OK);
+        ASSERT_TRUE(WaitCompletion(queue, &completion));
+        EXPECT_EQ(completion.result, CAML_INVALID_BYTE_STR);
+
+        EXPECT_EQ(AMLCompletionQueue_Pop(queue, &completion), CAML_QUEUE_EMPTY);
+        DestroyAMLObject(amlObj);
+#endif
+        DestroyAMLCompletionQueue(queue);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_AsyncTest, InvalidParam)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+        const uint8_t byte[] = { 0x00 };
+
+        EXPECT_EQ(Representation_DataToByteAsync(rep, amlObj, NULL, NULL), CAML_INVALID_PARAM);
+        EXPECT_EQ(Representation_DataToByteAsync(rep, (amlObjectHandle_t)byte, PostCompletion, NULL), CAML_INVALID_HANDLE);
+        EXPECT_EQ(Representation_ByteToDataAsync(rep, byte, 0, PostCompletion, NULL), CAML_INVALID_PARAM);
+        EXPECT_EQ(CreateAMLCompletionQueue(NULL), CAML_INVALID_PARAM);
+
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    struct PipelineContext
+    {
+        representation_t rep;
+        std::mutex mtx;
+        std::map<std::string, int> lastSequence;
+        int delivered;
+        bool inOrder;
+        std::atomic<bool> gate;
+        std::atomic<int> built;
+        std::atomic<int> discarded;
+    };
+
+    static int BuildRecord(void* record, amlObjectHandle_t* amlObjHandle, void* userData)
+    {
+        PipelineContext* context = (PipelineContext*)userData;
+        while (!context->gate)
+        {
+            std::this_thread::yield();
+        }
+
+        // The record is "<device>/<sequence>", carried in the ID of AMLObject.
+        std::string* str = (std::string*)record;
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+        CreateAMLObjectWithID(str->substr(0, str->find('/')).c_str(), "123456789", str->c_str(), amlObjHandle);
+
+        size_t count = 0;
+        AMLObject_GetDataCount(amlObj, &count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const char* name;
+            amlDataHandle_t data;
+            AMLObject_GetDataAt(amlObj, i, &name, &data);
+            AMLObject_AddData(*amlObjHandle, name, data);
+        }
+        DestroyAMLObject(amlObj);
+        delete str;
+        context->built++;
+        return 0;
+    }
+
+    static int RejectOdd(const amlObjectHandle_t amlObjHandle, void*)
+    {
+        char* id;
+        AMLObject_GetId(amlObjHandle, &id);
+        int sequence = atoi(strchr(id, '/') + 1);
+        free(id);
+        return sequence % 2;
+    }
+
+    static int CheckOrder(const char* deviceId, const uint8_t* data, size_t size, void* userData)
+    {
+        PipelineContext* context = (PipelineContext*)userData;
+
+        amlObjectHandle_t amlObj;
+        if (CAML_OK != Representation_ByteToData(context->rep, data, size, &amlObj))
+        {
+            return 1;
+        }
+        char* id;
+        AMLObject_GetId(amlObj, &id);
+        std::string str(id);
+        free(id);
+        DestroyAMLObject(amlObj);
+
+        std::lock_guard<std::mutex> lock(context->mtx);
+        int sequence = atoi(str.c_str() + str.find('/') + 1);
+        if (str.compare(0, str.find('/'), deviceId) != 0 ||
+            (context->lastSequence.count(deviceId) && context->lastSequence[deviceId] >= sequence))
+        {
+            context->inOrder = false;
+        }
+        context->lastSequence[deviceId] = sequence;
+        context->delivered++;
+        return 0;
+    }
+
+    static void DiscardRecord(void* record, void* userData)
+    {
+        delete (std::string*)record;
+        ((PipelineContext*)userData)->discarded++;
+    }
+
+    static void InitPipelineConfig(CAMLPipelineConfig& config, PipelineContext& context)
+    {
+        memset(&config, 0, sizeof(config));
+        config.build = BuildRecord;
+        config.sink = CheckOrder;
+        config.discard = DiscardRecord;
+        config.userData = &context;
+        config.format = CAML_FORMAT_BYTE;
+        for (int i = 0; i < CAML_PIPELINE_STAGES; i++)
+        {
+            config.workers[i] = 2;
+        }
+        config.queueCapacity = 4;
+        config.backpressure = CAML_BACKPRESSURE_BLOCK;
+
+        context.delivered = 0;
+        context.inOrder = true;
+        context.gate = true;
+        context.built = 0;
+        context.discarded = 0;
+    }
+
+    static std::string* NewRecord(const char* deviceId, int sequence)
+    {
+        return new std::string(std::string(deviceId) + "/" + std::to_string(sequence));
+    }
+
+    TEST(AMLPipelineTest, DeliverInOrder)
+    {
+        PipelineContext context;
+        CreateRepresentation(amlModelFile, &context.rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        CAMLPipelineConfig config;
+        InitPipelineConfig(config, context);
+        config.validate = RejectOdd;
+
+        amlPipeline_t pipeline;
+        EXPECT_EQ(CreateAMLPipeline(context.rep, &config, &pipeline), CAML_OK);
+
+        const char* devices[3] = { "DEVICE_A", "DEVICE_B", "DEVICE_C" };
+        for (int i = 0; i < 100; i++)
+        {
+            EXPECT_EQ(AMLPipeline_Push(pipeline, devices[i % 3], NewRecord(devices[i % 3], i)), CAML_OK);
+        }
+
+        CAMLPipelineStageMetrics metrics;
+        EXPECT_EQ(AMLPipeline_GetMetrics(pipeline, CAML_STAGE_BUILD, &metrics), CAML_OK);
+        EXPECT_EQ(metrics.queueCapacity, 8u);
+        EXPECT_LE(metrics.queueDepth, metrics.queueCapacity);
+        EXPECT_EQ(AMLPipeline_GetMetrics(pipeline, (CAMLPipelineStage)CAML_PIPELINE_STAGES, &metrics),
+                  CAML_INVALID_PARAM);
+
+        EXPECT_EQ(DestroyAMLPipeline(pipeline), CAML_OK);
+        EXPECT_EQ(context.delivered, 50);
+        EXPECT_TRUE(context.inOrder);
+        EXPECT_EQ(context.discarded, 0);
+#endif
+        DestroyRepresentation(context.rep);
+    }
+
+    TEST(AMLPipelineTest, DropOldest)
+    {
+        PipelineContext context;
+        CreateRepresentation(amlModelFile, &context.rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        CAMLPipelineConfig config;
+        InitPipelineConfig(config, context);
+        config.workers[CAML_STAGE_BUILD] = 1;
+        config.queueCapacity = 2;
+        config.backpressure = CAML_BACKPRESSURE_DROP_OLDEST;
+
+        amlPipeline_t pipeline;
+        EXPECT_EQ(CreateAMLPipeline(context.rep, &config, &pipeline), CAML_OK);
+
+        // Builder waits at the gate, so records pile up in its queue.
+        context.gate = false;
+        for (int i = 0; i < 20; i++)
+        {
+            EXPECT_EQ(AMLPipeline_Push(pipeline, "DEVICE_A", NewRecord("DEVICE_A", i)), CAML_OK);
+        }
+
+        CAMLPipelineStageMetrics build;
+        AMLPipeline_GetMetrics(pipeline, CAML_STAGE_BUILD, &build);
+        EXPECT_LE(build.queueDepth, 2u);
+        EXPECT_LE(17u, build.dropped);
+
+        context.gate = true;
+        EXPECT_EQ(DestroyAMLPipeline(pipeline), CAML_OK);
+        // Items can be dropped by later stages too, but each record is either built or discarded.
+        EXPECT_EQ(context.built + context.discarded, 20);
+        EXPECT_LE(context.delivered, context.built);
+        EXPECT_TRUE(context.inOrder);
+#endif
+        DestroyRepresentation(context.rep);
+    }
+
+    TEST(AMLPipelineTest, SmallestCapacity)
+    {
+        PipelineContext context;
+        CreateRepresentation(amlModelFile, &context.rep);
+
+#ifndef _DISABLE_PROTOBUF_
+        CAMLPipelineConfig config;
+        InitPipelineConfig(config, context);
+        for (int i = 0; i < CAML_PIPELINE_STAGES; i++)
+        {
+            config.workers[i] = 1;
+        }
+        config.queueCapacity = 1;
+
+        amlPipeline_t pipeline;
+        EXPECT_EQ(CreateAMLPipeline(context.rep, &config, &pipeline), CAML_OK);
+
+        CAMLPipelineStageMetrics metrics;
+        AMLPipeline_GetMetrics(pipeline, CAML_STAGE_BUILD, &metrics);
+        EXPECT_EQ(metrics.queueCapacity, 2u);
+
+        for (int i = 0; i < 30; i++)
+        {
+            EXPECT_EQ(AMLPipeline_Push(pipeline, "DEVICE_A", NewRecord("DEVICE_A", i)), CAML_OK);
+        }
+
+        EXPECT_EQ(DestroyAMLPipeline(pipeline), CAML_OK);
+        EXPECT_EQ(context.delivered, 30);
+        EXPECT_TRUE(context.inOrder);
+        EXPECT_EQ(context.discarded, 0);
+#endif
+        DestroyRepresentation(context.rep);
+    }
+
+    TEST(AMLPipelineTest, InvalidParam)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        PipelineContext context;
+        CAMLPipelineConfig config;
+        InitPipelineConfig(config, context);
+
+        amlPipeline_t pipeline;
+        config.sink = NULL;
+        EXPECT_EQ(CreateAMLPipeline(rep, &config, &pipeline), CAML_INVALID_PARAM);
+        config.sink = CheckOrder;
+        config.queueCapacity = 0;
+        EXPECT_EQ(CreateAMLPipeline(rep, &config, &pipeline), CAML_INVALID_PARAM);
+        EXPECT_EQ(AMLPipeline_Push(NULL, "DEVICE_A", NULL), CAML_INVALID_PARAM);
+
+        DestroyRepresentation(rep);
+    }
+
     TEST(GetRepresentationIdTest, GetValid)
     {   
         representation_t rep;
@@ -565,5 +1423,417 @@ namespace camlrepresentationtest
         amlObjectHandle_t config;
         EXPECT_EQ(Representation_GetConfigInfo(rep, &config), CAML_INVALID_HANDLE);
     }
+
+    TEST(GetSharedConfigInfoTest, SameFrozenHandle)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t config1, config2;
+        EXPECT_EQ(Representation_GetSharedConfigInfo(rep, &config1), CAML_OK);
+        EXPECT_EQ(Representation_GetSharedConfigInfo(rep, &config2), CAML_OK);
+        EXPECT_EQ(config1, config2);
+
+        amlDataHandle_t data;
+        EXPECT_EQ(AMLObject_GetData(config1, "Sample", &data), CAML_OK);
+        EXPECT_EQ(AMLData_SetValueStr(data, "key", "value"), CAML_OBJECT_FROZEN);
+        EXPECT_EQ(DestroyAMLObject(config1), CAML_INVALID_HANDLE);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(GetSharedConfigInfoTest, CopyIsOwned)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t shared, config;
+        EXPECT_EQ(Representation_GetSharedConfigInfo(rep, &shared), CAML_OK);
+        EXPECT_EQ(Representation_GetConfigInfo(rep, &config), CAML_OK);
+        EXPECT_NE(shared, config);
+
+        char* cycle;
+        amlDataHandle_t data;
+        AMLObject_GetData(config, "Sample", &data);
+        EXPECT_EQ(AMLData_GetValueStr(data, "cycle", &cycle), CAML_OK);
+        EXPECT_STREQ(cycle, "25");
+        free(cycle);
+
+        EXPECT_EQ(DestroyAMLObject(config), CAML_OK);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(GetSharedConfigInfoTest, InvalidHandle)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+        DestroyRepresentation(rep);
+
+        amlObjectHandle_t config;
+        EXPECT_EQ(Representation_GetSharedConfigInfo(rep, &config), CAML_INVALID_HANDLE);
+    }
+
+    TEST(GetCycleTest, Valid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        int64_t cycle = 0;
+        EXPECT_EQ(Representation_GetCycle(rep, "Sample", &cycle), CAML_OK);
+        EXPECT_EQ(cycle, 25);
+        EXPECT_EQ(Representation_GetCycle(rep, "Model", &cycle), CAML_OK);
+        EXPECT_EQ(cycle, CAML_CYCLE_ONCE);
+        EXPECT_EQ(Representation_GetCycle(rep, "Event", &cycle), CAML_KEY_NOT_EXIST);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(GetCycleTest, InvalidParam)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        int64_t cycle;
+        EXPECT_EQ(Representation_GetCycle(rep, NULL, &cycle), CAML_INVALID_PARAM);
+        EXPECT_EQ(Representation_GetCycle(rep, "Sample", NULL), CAML_INVALID_PARAM);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_PatchToByteTest, ConvertValid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t prevObj = TestAMLObjectHandle();
+
+        amlDataHandle_t model;
+        CreateAMLData(&model);
+        AMLData_SetValueStr(model, "a", "Model_107.113.97.249");
+        AMLData_SetValueStr(model, "b", "SR-P7-970");
+
+        amlObjectHandle_t currObj;
+        CreateAMLObject("SAMPLE001", "123456790", &currObj);
+        AMLObject_AddData(currObj, "Model", model);
+
+        amlPatchHandle_t patch;
+        AMLObject_Diff(prevObj, currObj, &patch);
+
+        uint8_t* byte;
+        size_t size;
+        EXPECT_EQ(Representation_PatchToByte(rep, patch, &byte, &size), CAML_OK);
+
+        amlPatchHandle_t received;
+        EXPECT_EQ(Representation_ByteToPatch(rep, byte, size, &received), CAML_OK);
+
+        amlObjectHandle_t result;
+        EXPECT_EQ(AMLObject_ApplyPatch(prevObj, received, &result), CAML_OK);
+        EXPECT_TRUE(isEqualAMLObject(currObj, result));
+
+        free(byte);
+        DestroyAMLObject(result);
+        DestroyAMLPatch(received);
+        DestroyAMLPatch(patch);
+        DestroyAMLData(model);
+        DestroyAMLObject(currObj);
+        DestroyAMLObject(prevObj);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_ByteToPatchTest, InvalidByte)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        std::string invalidBinary("invalidBinary");
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(Representation_ByteToPatch(rep, (uint8_t*)invalidBinary.c_str(), invalidBinary.size(), &patch), CAML_INVALID_BYTE_STR);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(Representation_ByteToPatchTest, InvalidHandle)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+        DestroyRepresentation(rep);
+
+        uint8_t binary[1] = {0};
+
+        amlPatchHandle_t patch;
+        EXPECT_EQ(Representation_ByteToPatch(rep, binary, 1, &patch), CAML_INVALID_HANDLE);
+    }
+
+    TEST(Representation_ByteToPatchTest, TooDeepData)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        // Writing does not limit the nesting, so that a patch of any depth can be made.
+        amlDataHandle_t nested;
+        CreateAMLData(&nested);
+        AMLData_SetValueStr(nested, "leaf", "value");
+        for (int i = 0; i < 100; i++)
+        {
+            amlDataHandle_t parent;
+            CreateAMLData(&parent);
+            AMLData_SetValueAMLData(parent, "child", nested);
+            DestroyAMLData(nested);
+            nested = parent;
+        }
+
+        amlObjectHandle_t prevObj;
+        CreateAMLObject("SAMPLE001", "123456789", &prevObj);
+        amlObjectHandle_t currObj;
+        CreateAMLObject("SAMPLE001", "123456790", &currObj);
+        AMLObject_AddData(currObj, "Deep", nested);
+
+        amlPatchHandle_t patch;
+        AMLObject_Diff(prevObj, currObj, &patch);
+
+        uint8_t* byte;
+        size_t size;
+        EXPECT_EQ(Representation_PatchToByte(rep, patch, &byte, &size), CAML_OK);
+
+        amlPatchHandle_t received;
+        EXPECT_EQ(Representation_ByteToPatch(rep, byte, size, &received), CAML_INVALID_BYTE_STR);
+
+        free(byte);
+        DestroyAMLPatch(patch);
+        DestroyAMLObject(currObj);
+        DestroyAMLObject(prevObj);
+        DestroyAMLData(nested);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(ConstructRepresentationFromBufferTest, ValidAML)
+    {
+        std::ifstream t(amlModelFile);
+        std::string model((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+
+        representation_t rep;
+        EXPECT_EQ(CreateRepresentationFromBuffer(model.c_str(), model.size(), &rep), CAML_OK);
+
+        char* repId;
+        EXPECT_EQ(Representation_GetRepId(rep, &repId), CAML_OK);
+        EXPECT_STREQ(repId, amlModelId);
+        free(repId);
+
+        DestroyRepresentation(rep);
+    }
+
+    TEST(ConstructRepresentationFromBufferTest, InvalidAML)
+    {
+        std::ifstream t(amlModelFile_invalid_NoCAEX);
+        std::string model((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+
+        representation_t rep;
+        EXPECT_EQ(CreateRepresentationFromBuffer(model.c_str(), model.size(), &rep), CAML_INVALID_AML_SCHEMA);
+        EXPECT_EQ(CreateRepresentationFromBuffer(model.c_str(), 0, &rep), CAML_INVALID_PARAM);
+    }
+
+    TEST(ConstructSharedRepresentationTest, SameFile)
+    {
+        representation_t rep1, rep2;
+        EXPECT_EQ(CreateSharedRepresentation(amlModelFile, &rep1), CAML_OK);
+        EXPECT_EQ(CreateSharedRepresentation("../unittests/TEST_DataModel.aml", &rep2), CAML_OK);
+        EXPECT_NE(rep1, rep2);
+
+        EXPECT_EQ(DestroyRepresentation(rep1), CAML_OK);
+
+        char* repId;
+        EXPECT_EQ(Representation_GetRepId(rep2, &repId), CAML_OK);
+        EXPECT_STREQ(repId, amlModelId);
+        free(repId);
+
+        EXPECT_EQ(DestroyRepresentation(rep2), CAML_OK);
+        EXPECT_EQ(DestroyRepresentation(rep2), CAML_INVALID_HANDLE);
+    }
+
+    TEST(ConstructSharedRepresentationTest, SameContent)
+    {
+        std::ifstream t(amlModelFile);
+        std::string model((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+
+        representation_t rep1, rep2;
+        EXPECT_EQ(CreateSharedRepresentationFromBuffer(model.c_str(), model.size(), &rep1), CAML_OK);
+        EXPECT_EQ(CreateSharedRepresentationFromBuffer(model.c_str(), model.size(), &rep2), CAML_OK);
+
+        char* repId;
+        EXPECT_EQ(Representation_GetRepId(rep2, &repId), CAML_OK);
+        EXPECT_STREQ(repId, amlModelId);
+        free(repId);
+
+        DestroyRepresentation(rep1);
+        DestroyRepresentation(rep2);
+    }
+
+    TEST(ConstructSharedRepresentationTest, InvalidAML)
+    {
+        representation_t rep;
+        EXPECT_EQ(CreateSharedRepresentation("NoExist.aml", &rep), CAML_INVALID_FILE_PATH);
+        EXPECT_EQ(CreateSharedRepresentation(amlModelFile_invalid_NoCAEX, &rep), CAML_INVALID_AML_SCHEMA);
+    }
+
+    TEST(ConstructLazyRepresentationTest, LoadClassOnUse)
+    {
+        representation_t rep;
+        EXPECT_EQ(CreateLazyRepresentation(amlModelFile, &rep), CAML_OK);
+
+        char* repId;
+        EXPECT_EQ(Representation_GetRepId(rep, &repId), CAML_OK);
+        EXPECT_STREQ(repId, amlModelId);
+        free(repId);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        uint8_t* byte;
+        size_t size;
+        EXPECT_EQ(Representation_DataToByte(rep, amlObj, &byte, &size), CAML_OK);
+
+        amlObjectHandle_t decoded;
+        EXPECT_EQ(Representation_ByteToData(rep, byte, size, &decoded), CAML_OK);
+        free(byte);
+
+        char** names;
+        size_t namesSize;
+        EXPECT_EQ(AMLObject_GetDataNames(decoded, &names, &namesSize), CAML_OK);
+        EXPECT_EQ(namesSize, 2u);
+        for (size_t i = 0; i < namesSize; i++)
+        {
+            free(names[i]);
+        }
+        free(names);
+
+        DestroyAMLObject(decoded);
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(ConstructLazyRepresentationTest, LoadOnlyUsedClasses)
+    {
+        representation_t rep;
+        EXPECT_EQ(CreateLazyRepresentation(amlModelFile, &rep), CAML_OK);
+
+        // Only "Event" is loaded for the header of AMLObject.
+        size_t loaded, total;
+        EXPECT_EQ(Representation_GetLoadedClassCount(rep, &loaded, &total), CAML_OK);
+        EXPECT_EQ(loaded, 1u);
+        EXPECT_EQ(total, 3u);
+
+#ifndef _DISABLE_PROTOBUF_
+        amlDataHandle_t model;
+        CreateAMLData(&model);
+        AMLData_SetValueStr(model, "a", "Model_107.113.97.248");
+        AMLData_SetValueStr(model, "b", "SR-P7-970");
+
+        amlObjectHandle_t amlObj;
+        CreateAMLObject("SAMPLE001", "1", &amlObj);
+        AMLObject_AddData(amlObj, "Model", model);
+
+        uint8_t* byte;
+        size_t size;
+        EXPECT_EQ(Representation_DataToByte(rep, amlObj, &byte, &size), CAML_OK);
+        EXPECT_EQ(Representation_GetLoadedClassCount(rep, &loaded, &total), CAML_OK);
+        EXPECT_EQ(loaded, 2u);
+
+        amlObjectHandle_t decoded;
+        EXPECT_EQ(Representation_ByteToData(rep, byte, size, &decoded), CAML_OK);
+        EXPECT_EQ(Representation_GetLoadedClassCount(rep, &loaded, &total), CAML_OK);
+        EXPECT_EQ(loaded, total);
+
+        free(byte);
+        DestroyAMLObject(decoded);
+        DestroyAMLObject(amlObj);
+        DestroyAMLData(model);
+#endif
+        DestroyRepresentation(rep);
+
+        CreateRepresentation(amlModelFile, &rep);
+        EXPECT_EQ(Representation_GetLoadedClassCount(rep, &loaded, &total), CAML_INVALID_HANDLE);
+        DestroyRepresentation(rep);
+    }
+
+    TEST(ConstructLazyRepresentationTest, SameAmlAsFullModel)
+    {
+        representation_t lazyRep;
+        representation_t fullRep;
+        CreateLazyRepresentation(amlModelFile, &lazyRep);
+        CreateRepresentation(amlModelFile, &fullRep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        // AML(XML) string has the SystemUnitClassLib of the whole model, not of the classes loaded so far.
+        char* lazyAml;
+        char* fullAml;
+        EXPECT_EQ(Representation_DataToAml(lazyRep, amlObj, &lazyAml), CAML_OK);
+        EXPECT_EQ(Representation_DataToAml(fullRep, amlObj, &fullAml), CAML_OK);
+        EXPECT_STREQ(lazyAml, fullAml);
+
+        free(lazyAml);
+        free(fullAml);
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(lazyRep);
+        DestroyRepresentation(fullRep);
+    }
+
+    TEST(ConstructLazyRepresentationTest, InvalidFilePath)
+    {
+        representation_t rep;
+        EXPECT_EQ(CreateLazyRepresentation("NoExist.aml", &rep), CAML_INVALID_FILE_PATH);
+    }
+
+    TEST(Representation_ReloadTest, Valid)
+    {
+        representation_t rep;
+        CreateRepresentation(amlModelFile, &rep);
+
+        EXPECT_EQ(Representation_Reload(rep, amlModelFile_invalid_NoSUCL), CAML_INVALID_AML_SCHEMA);
+
+        std::ifstream t(amlModelFile);
+        std::string model((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(Representation_ReloadFromBuffer(rep, model.c_str(), model.size()), CAML_OK);
+        EXPECT_EQ(Representation_Reload(rep, amlModelFile), CAML_OK);
+
+        char* repId;
+        EXPECT_EQ(Representation_GetRepId(rep, &repId), CAML_OK);
+        EXPECT_STREQ(repId, amlModelId);
+        free(repId);
+
+        DestroyRepresentation(rep);
+        EXPECT_EQ(Representation_Reload(rep, amlModelFile), CAML_INVALID_HANDLE);
+    }
+
+    TEST(Representation_ReloadTest, ReloadWhileConverting)
+    {
+        representation_t rep;
+        CreateLazyRepresentation(amlModelFile, &rep);
+
+        amlObjectHandle_t amlObj = TestAMLObjectHandle();
+
+        std::atomic<bool> done(false);
+        std::thread converter([&]()
+        {
+            while (!done)
+            {
+                uint8_t* byte;
+                size_t size;
+                EXPECT_EQ(Representation_DataToByte(rep, amlObj, &byte, &size), CAML_OK);
+                free(byte);
+            }
+        });
+
+        for (int i = 0; i < 20; i++)
+        {
+            EXPECT_EQ(Representation_Reload(rep, amlModelFile), CAML_OK);
+        }
+
+        done = true;
+        converter.join();
+
+        DestroyAMLObject(amlObj);
+        DestroyRepresentation(rep);
+    }
 }
 